@@ -1,10 +1,16 @@
 #pragma once
 
 #include "gpu_detector.hpp"
+#include "drm_fdinfo.hpp"
+#include "amd_gpu_metrics.hpp"
 #include <string>
 #include <vector>
 #include <optional>
 #include <filesystem>
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <functional>
 
 namespace hw_monitor {
 
@@ -17,8 +23,38 @@ namespace hw_monitor {
  */
 class AMDGPUDetector : public IGPUDetector {
 private:
+    /**
+     * @brief Per-card paths and open sysfs files, resolved once at construction
+     */
+    struct CardHandles {
+        std::string path;            ///< /sys/class/drm/cardN
+        uint32_t index;              ///< N in cardN
+        std::string name;            ///< Product name
+        std::string pdev;            ///< PCI address, matched against DRM fdinfo drm-pdev
+        std::string render_node;     ///< /dev/dri/renderDN of this card, empty if none
+        std::string hwmon_dir;       ///< hwmon directory, empty if none
+        int metrics_fd = -1;         ///< gpu_metrics
+        int busy_fd = -1;            ///< gpu_busy_percent
+        int vram_total_fd = -1;      ///< mem_info_vram_total
+        int vram_used_fd = -1;       ///< mem_info_vram_used
+        int temp_fd = -1;            ///< Lowest numbered hwmon temp*_input (edge temperature)
+        uint32_t kfd_gpu_id = 0;     ///< KFD topology gpu_id, 0 if the card has no KFD node
+        uint32_t compute_units = 0;  ///< Compute units reported by the KFD topology
+    };
+
+    /**
+     * @brief Previous cumulative SDMA time of a process on a card
+     */
+    struct SdmaSample {
+        uint64_t usec;
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
     bool initialized_;                    ///< Indicates if AMD GPU was successfully detected
-    std::vector<std::string> gpu_paths_;  ///< Paths to AMD GPU devices in sysfs
+    std::vector<CardHandles> cards_;      ///< AMD GPUs found in sysfs
+    mutable DRMFdinfoReader fdinfo_reader_;  ///< Per-process engine and memory accounting
+    mutable std::mutex kfd_mutex_;           ///< Guards previous_sdma_
+    mutable std::map<std::pair<uint32_t, uint32_t>, SdmaSample> previous_sdma_;  ///< Keyed by PID and KFD gpu_id
 
     /**
      * @brief Print debug messages to stderr
@@ -33,6 +69,13 @@ private:
      */
     static std::string read_file(const std::string& path);
 
+    /**
+     * @brief Read a decimal value from an open sysfs file with pread
+     * @param fd Open file descriptor, or -1
+     * @return The value, or nullopt if the file is not open or unreadable
+     */
+    static std::optional<uint64_t> read_number(int fd);
+
     /**
      * @brief Find the hwmon directory for a GPU card
      * @param card_path Path to the GPU card directory
@@ -40,6 +83,32 @@ private:
      */
     static std::string find_hwmon_dir(const std::string& card_path);
 
+    /**
+     * @brief Find the render node of a GPU card
+     * @param card_path Path to the GPU card directory
+     * @return /dev/dri/renderDN, or empty string if the card has none
+     */
+    static std::string find_render_node(const std::string& card_path);
+
+    /**
+     * @brief Match cards to KFD topology nodes through their render minor
+     *
+     * Fills kfd_gpu_id and compute_units of each card from
+     * /sys/class/kfd/kfd/topology/nodes/N/{gpu_id,properties}.
+     */
+    void resolve_kfd_topology();
+
+    /**
+     * @brief Read per-process compute accounting from /sys/class/kfd/kfd/proc
+     * @param process_matches Predicate selecting the PIDs to report
+     * @return One entry per process and card, with VRAM and "compute"/"sdma" engine usage
+     *
+     * Only processes that opened the KFD device are listed there, so this needs no
+     * scan of /proc. SDMA activity is the delta since the previous call; counters of
+     * processes no longer listed are dropped.
+     */
+    std::vector<GPUProcessInfo> read_kfd_processes(const std::function<bool(uint32_t)>& process_matches) const;
+
     /**
      * @brief Check if a device is an AMD GPU
      * @param path Path to the device directory
@@ -51,14 +120,18 @@ public:
     /**
      * @brief Constructor that initializes AMD GPU detection
      * 
-     * Scans the system for AMD GPUs by checking /sys/class/drm for devices with AMD vendor ID (0x1002).
+     * Scans the system for AMD GPUs by checking /sys/class/drm for devices with AMD vendor ID (0x1002),
+     * and opens the sysfs files sampled by get_gpu_info().
      */
     AMDGPUDetector();
     
     /**
-     * @brief Virtual destructor
+     * @brief Destructor, closes the cached sysfs files
      */
-    ~AMDGPUDetector() override = default;
+    ~AMDGPUDetector() override;
+
+    AMDGPUDetector(const AMDGPUDetector&) = delete;
+    AMDGPUDetector& operator=(const AMDGPUDetector&) = delete;
 
     /**
      * @brief Check if AMD GPU is available in the system
@@ -69,6 +142,10 @@ public:
     /**
      * @brief Get information about all AMD GPUs in the system
      * @return Vector of GPUInfo structures containing information about each GPU
+     *
+     * Temperature, activity, power, clocks and throttle status come from a single
+     * read of gpu_metrics where the kernel provides it, falling back to the
+     * individual sysfs and hwmon files otherwise.
      */
     std::vector<GPUInfo> get_gpu_info() const override;
 
@@ -77,10 +154,11 @@ public:
      * @param process_name Name of the process to monitor
      * @return Optional vector of GPUProcessInfo structures, or nullopt if process not found
      * 
-     * Searches for the specified process and collects its GPU usage information by:
-     * - Checking process maps for GPU memory regions
-     * - Analyzing file descriptors for GPU device access
-     * - Calculating memory usage and utilization
+     * Matching processes are found with one scan of /proc. ROCm compute processes
+     * among them are read from KFD accounting; engine busy percentages and VRAM of
+     * the others come from DRM fdinfo. Processes that hold a card open without an
+     * fdinfo client (kernels without DRM fdinfo stats) are reported with memory
+     * estimated from their render node mappings and unknown (-1) utilization.
      */
     std::optional<std::vector<GPUProcessInfo>> get_process_info(const std::string& process_name) const override;
 
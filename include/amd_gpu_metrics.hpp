@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+namespace hw_monitor {
+
+/**
+ * @brief Decoded contents of the amdgpu gpu_metrics blob
+ *
+ * /sys/class/drm/cardN/device/gpu_metrics holds a versioned binary struct
+ * (struct gpu_metrics_vX_Y in the kernel's kgd_pp_interface.h). Layouts differ
+ * between dGPUs (v1.x), APUs (v2.x) and newer APUs (v3.x), and fields a
+ * particular ASIC does not report are left empty.
+ */
+struct AMDGPUMetrics {
+    uint8_t format_revision;                        ///< Major layout version (1 = dGPU, 2/3 = APU)
+    uint8_t content_revision;                       ///< Minor layout version
+    std::optional<float> temperature_celsius;       ///< Edge (dGPU) or GFX (APU) temperature
+    std::optional<float> hotspot_celsius;           ///< Junction temperature
+    std::optional<float> memory_temperature_celsius;///< HBM/VRAM temperature
+    std::optional<float> gfx_activity_percent;      ///< GFX engine activity (0-100)
+    std::optional<float> memory_activity_percent;   ///< Memory controller activity (0-100)
+    std::optional<float> media_activity_percent;    ///< UVD/VCN activity (0-100)
+    std::optional<float> socket_power_watts;        ///< Socket power (dGPU, or APU package)
+    std::optional<uint32_t> gfx_clock_mhz;          ///< Current (or average, where only that is reported) GFX clock
+    std::optional<uint32_t> soc_clock_mhz;          ///< SoC clock
+    std::optional<uint32_t> memory_clock_mhz;       ///< Memory (UCLK) clock
+    std::optional<uint32_t> fan_speed_rpm;          ///< Fan speed (dGPU only)
+    std::optional<uint64_t> throttle_status;        ///< ASIC-specific throttle status bitmask
+};
+
+/**
+ * @brief Parse a gpu_metrics blob
+ * @param data Raw bytes as read from sysfs
+ * @param size Number of bytes read
+ * @return Decoded metrics, or nullopt if the header is truncated or the version is unknown
+ *         or unsupported (v1.0)
+ */
+std::optional<AMDGPUMetrics> parse_gpu_metrics(const uint8_t* data, size_t size);
+
+/**
+ * @brief Read and parse gpu_metrics with a single pread
+ * @param fd Open file descriptor of the gpu_metrics sysfs file
+ * @return Decoded metrics, or nullopt on read or parse failure
+ */
+std::optional<AMDGPUMetrics> read_gpu_metrics(int fd);
+
+} // namespace hw_monitor
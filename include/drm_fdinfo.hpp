@@ -0,0 +1,129 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <optional>
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+
+namespace hw_monitor {
+
+/**
+ * @brief Raw counters of one DRM client, parsed from /proc/[pid]/fdinfo
+ *
+ * Follows the DRM client usage stats format shared by amdgpu, i915, xe, msm,
+ * panfrost and other drivers (Documentation/gpu/drm-usage-stats.rst).
+ */
+struct DRMClientSample {
+    uint32_t pid;                                       ///< Process holding the DRM file descriptor
+    std::string driver;                                 ///< drm-driver
+    std::string pdev;                                   ///< drm-pdev, PCI address of the device
+    uint64_t client_id;                                 ///< drm-client-id, shared by duplicated file descriptors
+    std::map<std::string, uint64_t> engine_ns;          ///< drm-engine-<engine>: busy time in nanoseconds
+    std::map<std::string, uint64_t> engine_capacity;    ///< drm-engine-capacity-<engine>: number of engine instances
+    std::map<std::string, uint64_t> cycles;             ///< drm-cycles-<engine>: busy cycles
+    std::map<std::string, uint64_t> total_cycles;       ///< drm-total-cycles-<engine>: elapsed cycles
+    std::map<std::string, uint64_t> memory_bytes;       ///< Resident memory per region (vram, gtt, system, ...)
+    std::chrono::steady_clock::time_point timestamp;    ///< When the counters were read
+};
+
+/**
+ * @brief GPU usage of one process on one DRM device, aggregated over its DRM clients
+ */
+struct DRMProcessUsage {
+    uint32_t pid;                                       ///< Process ID
+    std::string process_name;                           ///< Name of the process
+    std::string driver;                                 ///< Kernel driver (amdgpu, i915, xe, ...)
+    std::string pdev;                                   ///< PCI address of the device
+    std::map<std::string, float> engine_busy_percent;   ///< Busy percentage per engine (0-100)
+    std::map<std::string, uint64_t> memory_bytes;       ///< Resident memory per region
+    uint32_t client_count;                              ///< Number of distinct DRM clients of the process
+};
+
+/**
+ * @brief Per-process GPU engine and memory accounting from DRM fdinfo
+ *
+ * Walks /proc/[pid]/fd for DRM device nodes and reads the matching fdinfo entries.
+ * Clients are deduplicated by client ID, so duplicated or inherited file
+ * descriptors are counted once. Engine busy percentages are computed from counter
+ * deltas between calls; clients seen for the first time are sampled twice, 100ms apart.
+ */
+class DRMFdinfoReader {
+public:
+    /**
+     * @brief Constructor
+     * @param proc_root Root of the proc filesystem, overridable for testing against a fake tree
+     */
+    explicit DRMFdinfoReader(std::string proc_root = "/proc");
+
+    /**
+     * @brief Parse the DRM usage keys of one fdinfo file
+     * @param path Path to /proc/[pid]/fdinfo/[fd]
+     * @return Client counters, or nullopt if the file does not describe a DRM client
+     */
+    static std::optional<DRMClientSample> parse_fdinfo(const std::string& path);
+
+    /**
+     * @brief Read the counters of every DRM client, deduplicated by client ID
+     * @param pid_filter Optional predicate; processes it rejects are not inspected
+     * @return One sample per distinct DRM client
+     */
+    std::vector<DRMClientSample> read_clients(const std::function<bool(uint32_t)>& pid_filter = nullptr) const;
+
+    /**
+     * @brief Read the counters of the DRM clients of the given processes, without listing /proc
+     * @param pids Processes to inspect
+     * @return One sample per distinct DRM client
+     */
+    std::vector<DRMClientSample> read_clients(const std::vector<uint32_t>& pids) const;
+
+    /**
+     * @brief Get per-process engine usage and memory since the previous call
+     * @param pid_filter Optional predicate; processes it rejects are not inspected
+     * @return Usage per process and DRM device
+     */
+    std::vector<DRMProcessUsage> sample(const std::function<bool(uint32_t)>& pid_filter = nullptr);
+
+    /**
+     * @brief Get engine usage and memory since the previous call for the given processes
+     * @param pids Processes to inspect, e.g. already resolved by the caller's own /proc scan
+     * @return Usage per process and DRM device
+     */
+    std::vector<DRMProcessUsage> sample(const std::vector<uint32_t>& pids);
+
+private:
+    /**
+     * @brief Counters of a client from the previous call, keyed by device and client ID
+     */
+    struct PreviousCounters {
+        std::map<std::string, uint64_t> engine_ns;
+        std::map<std::string, uint64_t> cycles;
+        std::map<std::string, uint64_t> total_cycles;
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
+    /// Counters not refreshed for this long are dropped after a filtered sample
+    static constexpr std::chrono::minutes stale_after{5};
+
+    std::string proc_root_;                                  ///< Root of the proc filesystem
+    std::mutex mutex_;                                       ///< Guards previous_
+    std::map<std::string, PreviousCounters> previous_;       ///< Counters from the previous call
+
+    /**
+     * @brief Key identifying a DRM client across calls
+     */
+    static std::string client_key(const DRMClientSample& client);
+
+    /**
+     * @brief Shared implementation of sample()
+     * @param read Reads the current counters of the selected clients
+     * @param filtered Whether read covers only some processes, so unseen clients are kept
+     */
+    std::vector<DRMProcessUsage> sample_clients(const std::function<std::vector<DRMClientSample>()>& read,
+                                                bool filtered);
+};
+
+} // namespace hw_monitor
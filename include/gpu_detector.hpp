@@ -4,6 +4,9 @@
 #include <vector>
 #include <optional>
 #include <memory>
+#include <cstdint>
+#include <functional>
+#include <map>
 
 namespace hw_monitor {
 
@@ -16,6 +19,7 @@ struct GPUProcessInfo {
     uint32_t gpu_index;                     ///< Index of the GPU this process is running on
     float memory_usage_mb;                  ///< GPU memory usage in megabytes
     float gpu_usage_percent;                ///< GPU utilization percentage (0-100)
+    std::map<std::string, float> engine_usage_percent;  ///< Busy percentage per engine (gfx, compute, video, ...) where known
 };
 
 /**
@@ -24,13 +28,103 @@ struct GPUProcessInfo {
 struct GPUInfo {
     uint32_t index;                         ///< GPU device index
     std::string name;                       ///< GPU device name/model
+    std::string uuid;                       ///< Unique device identifier (empty if unknown)
+    std::string pci_bus_id;                 ///< PCI bus ID, e.g. "0000:01:00.0" (empty if unknown)
     float total_memory_mb;                  ///< Total GPU memory in megabytes
     float used_memory_mb;                   ///< Used GPU memory in megabytes
     float temperature_celsius;              ///< GPU temperature in Celsius
     float utilization_percent;              ///< GPU utilization percentage (0-100)
     std::vector<GPUProcessInfo> processes;  ///< List of processes using this GPU
+
+    // Extended telemetry; -1 when the device or driver does not report the value
+    float power_draw_watts = -1;            ///< Current power draw in watts
+    float power_limit_watts = -1;           ///< Enforced power limit in watts
+    int32_t sm_clock_mhz = -1;              ///< Current SM clock in MHz
+    int32_t memory_clock_mhz = -1;          ///< Current memory clock in MHz
+    int32_t graphics_clock_mhz = -1;        ///< Current graphics clock in MHz
+    int32_t requested_graphics_clock_mhz = -1; ///< Graphics clock requested by the driver in MHz
+    int64_t pcie_tx_kbps = -1;              ///< PCIe transmit throughput in KB/s
+    int64_t pcie_rx_kbps = -1;              ///< PCIe receive throughput in KB/s
+    float encoder_utilization_percent = -1; ///< Video encoder utilization percentage (0-100)
+    float decoder_utilization_percent = -1; ///< Video decoder utilization percentage (0-100)
+    float fan_speed_percent = -1;           ///< Fan speed as percentage of maximum
+    int32_t performance_state = -1;         ///< Performance state (0 = P0, maximum performance, to 15)
+    int64_t throttle_reasons = -1;          ///< Bitmask of active clock throttle reasons (vendor-specific)
+    int64_t ecc_corrected_errors = -1;      ///< Corrected ECC errors since the driver was loaded
+    int64_t ecc_uncorrected_errors = -1;    ///< Uncorrected ECC errors since the driver was loaded
+    float rc6_residency_percent = -1;       ///< Time spent in the RC6 idle state since the previous call
+    double energy_joules = -1;              ///< Energy consumed since the driver was loaded
+};
+
+/**
+ * @brief Per-process GPU accounting record, available after the process exits
+ */
+struct GPUAccountingInfo {
+    uint32_t pid;                           ///< Process ID
+    std::string process_name;               ///< Name of the process (empty if it exited before it was seen)
+    uint32_t gpu_index;                     ///< Index of the GPU the process ran on
+    float gpu_utilization_percent;          ///< Average GPU utilization over the process lifetime
+    float memory_utilization_percent;       ///< Average memory utilization over the process lifetime
+    float max_memory_usage_mb;              ///< Peak GPU memory usage in megabytes
+    uint64_t run_time_ms;                   ///< Time the process ran on the GPU in milliseconds
+    uint64_t start_time_us;                 ///< Start time, microseconds since the Unix epoch
+    bool is_running;                        ///< Whether the process was still running when sampled
+};
+
+/**
+ * @brief Metrics with a driver-side sample history
+ */
+enum class GPUSampleType {
+    PowerWatts,                             ///< Power draw in watts
+    GPUUtilization,                         ///< GPU utilization percentage
+    MemoryUtilization,                      ///< Memory controller utilization percentage
+    EncoderUtilization,                     ///< Video encoder utilization percentage
+    DecoderUtilization,                     ///< Video decoder utilization percentage
+    ProcessorClockMHz,                      ///< Processor clock in MHz
+    MemoryClockMHz                          ///< Memory clock in MHz
+};
+
+/**
+ * @brief Distribution of a metric over the samples taken since the previous poll
+ */
+struct GPUSampleStats {
+    uint32_t gpu_index;                     ///< GPU device index
+    GPUSampleType type;                     ///< Metric the samples belong to
+    uint32_t sample_count;                  ///< Number of samples in the interval
+    double min;                             ///< Smallest sample
+    double max;                             ///< Largest sample
+    double mean;                            ///< Mean of the samples
+    double p50;                             ///< Median
+    double p90;                             ///< 90th percentile
+    double p99;                             ///< 99th percentile
+    uint64_t first_timestamp_us;            ///< Timestamp of the oldest sample, microseconds since the Unix epoch
+    uint64_t last_timestamp_us;             ///< Timestamp of the newest sample, microseconds since the Unix epoch
+};
+
+/**
+ * @brief Kinds of asynchronous GPU events
+ */
+enum class GPUEventType {
+    XidCriticalError,                       ///< Critical XID error; data holds the XID code
+    DoubleBitEccError,                      ///< Uncorrectable (double-bit) ECC error
+    SingleBitEccError,                      ///< Corrected (single-bit) ECC error
+    PerformanceStateChange,                 ///< Performance state changed
+    ClockChange                             ///< Clock frequency changed
 };
 
+/**
+ * @brief Asynchronous event reported by a GPU
+ */
+struct GPUEvent {
+    uint32_t gpu_index;                     ///< Index of the GPU that raised the event
+    GPUEventType type;                      ///< Kind of event
+    uint64_t data;                          ///< Event-specific payload (XID code for XID errors)
+    uint64_t timestamp_us;                  ///< Time the event was received, microseconds since the Unix epoch
+};
+
+/// Callback receiving GPU events, invoked from the listener thread
+using GPUEventCallback = std::function<void(const GPUEvent&)>;
+
 /**
  * @brief Interface for vendor-specific GPU detection implementations
  * 
@@ -73,6 +167,30 @@ public:
      * @return GPU information if the GPU exists
      */
     virtual std::optional<GPUInfo> get_gpu_info(uint32_t gpu_index) const = 0;
+
+    /**
+     * @brief Start delivering asynchronous GPU events from a background thread
+     * @param callback Function called for every event
+     * @return true if the implementation supports events and the listener started
+     */
+    virtual bool start_event_listener(GPUEventCallback callback) { (void)callback; return false; }
+
+    /**
+     * @brief Stop the event listener thread if it is running
+     */
+    virtual void stop_event_listener() {}
+
+    /**
+     * @brief Summarize the driver's sample history since the previous call
+     * @return Statistics per GPU and metric with new samples; empty if unsupported
+     */
+    virtual std::vector<GPUSampleStats> get_sample_stats() const { return {}; }
+
+    /**
+     * @brief Get accounting records of running processes and of processes that finished since the previous call
+     * @return Accounting records; empty if accounting is unsupported or disabled
+     */
+    virtual std::vector<GPUAccountingInfo> get_accounting_info() const { return {}; }
 };
 
 /**
@@ -116,6 +234,40 @@ public:
      */
     std::optional<GPUInfo> get_gpu_info(uint32_t gpu_index) const;
 
+    /**
+     * @brief Summarize the high-resolution sample history of all GPUs
+     *
+     * Covers every sample recorded since the previous call, so even slow polling
+     * catches sub-second idle gaps and spikes.
+     * @return Statistics per GPU and metric
+     */
+    std::vector<GPUSampleStats> get_sample_stats() const;
+
+    /**
+     * @brief Get per-process accounting records, including processes that already exited
+     *
+     * Requires accounting mode to be enabled on the GPU (nvidia-smi -am 1). Each
+     * call returns all running processes plus the processes that finished since
+     * the previous call; finished processes are reported exactly once.
+     * @return Accounting records for all GPUs
+     */
+    std::vector<GPUAccountingInfo> get_accounting_info() const;
+
+    /**
+     * @brief Start delivering XID, ECC, performance state and clock events
+     *
+     * Events replace polling for these failure signals; the callback runs on
+     * a listener thread owned by each vendor implementation.
+     * @param callback Function called for every event
+     * @return true if at least one implementation started listening
+     */
+    bool start_event_listener(GPUEventCallback callback);
+
+    /**
+     * @brief Stop all event listener threads
+     */
+    void stop_event_listener();
+
 private:
     GPUDetector();
     ~GPUDetector() = default;
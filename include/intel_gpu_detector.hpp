@@ -0,0 +1,161 @@
+#pragma once
+
+#include "gpu_detector.hpp"
+#include "drm_fdinfo.hpp"
+#include <string>
+#include <vector>
+#include <optional>
+#include <mutex>
+#include <chrono>
+#include <functional>
+
+namespace hw_monitor {
+
+/**
+ * @brief Intel GPU detector class for monitoring i915 and xe graphics devices
+ *
+ * Discovers Intel GPUs (vendor ID 0x8086) in /sys/class/drm and reports their
+ * frequency, RC6 residency and hwmon power and energy. Per-process engine usage
+ * and memory come from DRM fdinfo.
+ */
+class IntelGPUDetector : public IGPUDetector {
+private:
+    /**
+     * @brief Per-card paths and open sysfs files, resolved once at construction
+     */
+    struct CardHandles {
+        std::string path;                 ///< <sysfs>/class/drm/cardN
+        uint32_t index;                   ///< N in cardN
+        std::string name;                 ///< Display name
+        std::string driver;               ///< "i915" or "xe"
+        std::string pdev;                 ///< PCI address, matched against DRM fdinfo drm-pdev
+        int act_freq_fd = -1;             ///< Actual GT frequency in MHz
+        int cur_freq_fd = -1;             ///< Requested GT frequency in MHz
+        int rc6_fd = -1;                  ///< Cumulative RC6 residency in ms
+        int energy_fd = -1;               ///< hwmon energy1_input in microjoules
+        int power_limit_fd = -1;          ///< hwmon power1_max in microwatts
+        int temp_fd = -1;                 ///< Lowest numbered hwmon temp*_input
+
+        // Counters from the previous call, for RC6 residency and power
+        mutable std::optional<uint64_t> previous_rc6_ms;
+        mutable std::optional<uint64_t> previous_energy_uj;
+        mutable std::chrono::steady_clock::time_point previous_timestamp;
+    };
+
+    /**
+     * @brief Cumulative counters of one card at one point in time
+     */
+    struct CounterSample {
+        std::optional<uint64_t> rc6_ms;
+        std::optional<uint64_t> energy_uj;
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
+    bool initialized_;                       ///< Indicates if an Intel GPU was successfully detected
+    std::string proc_root_;                  ///< Root of the proc filesystem
+    std::vector<CardHandles> cards_;         ///< Intel GPUs found in sysfs
+    mutable std::mutex counters_mutex_;      ///< Guards the previous_* counters of cards_
+    mutable DRMFdinfoReader fdinfo_reader_;  ///< Per-process engine and memory accounting
+
+    /**
+     * @brief Print debug messages to stderr
+     * @param msg The message to print
+     */
+    void debug_print(const std::string& msg) const;
+
+    /**
+     * @brief Read contents of a file
+     * @param path Path to the file
+     * @return String containing the first line of the file, or empty string if file cannot be read
+     */
+    static std::string read_file(const std::string& path);
+
+    /**
+     * @brief Read a decimal value from an open sysfs file with pread
+     * @param fd Open file descriptor, or -1
+     * @return The value, or nullopt if the file is not open or unreadable
+     */
+    static std::optional<uint64_t> read_number(int fd);
+
+    /**
+     * @brief Open the first of several candidate files that exists
+     * @param candidates Paths in order of preference
+     * @return Open file descriptor, or -1 if none could be opened
+     */
+    static int open_first(const std::vector<std::string>& candidates);
+
+    /**
+     * @brief Read the cumulative RC6 and energy counters of a card
+     */
+    static CounterSample read_counters(const CardHandles& card);
+
+    /**
+     * @brief Collect per-process usage of Intel GPUs from DRM fdinfo
+     * @param pid_filter Predicate selecting the PIDs to report
+     * @return One entry per process and card
+     */
+    std::vector<GPUProcessInfo> collect_processes(const std::function<bool(uint32_t)>& pid_filter) const;
+
+public:
+    /**
+     * @brief Constructor that initializes Intel GPU detection
+     * @param sysfs_root Root of the sysfs filesystem, overridable for testing against a fake tree
+     *                   (see tools/intel_gpu_fixture)
+     * @param proc_root Root of the proc filesystem, overridable for testing against a fake tree
+     *
+     * Scans <sysfs_root>/class/drm for cards with Intel vendor ID (0x8086) bound to the
+     * i915 or xe driver, and opens the sysfs files sampled by get_gpu_info(). Frequency
+     * and RC6 files are taken from the card directory (i915) or tile0/gt0 (xe).
+     */
+    explicit IntelGPUDetector(const std::string& sysfs_root = "/sys", std::string proc_root = "/proc");
+
+    /**
+     * @brief Destructor, closes the cached sysfs files
+     */
+    ~IntelGPUDetector() override;
+
+    IntelGPUDetector(const IntelGPUDetector&) = delete;
+    IntelGPUDetector& operator=(const IntelGPUDetector&) = delete;
+
+    /**
+     * @brief Check if an Intel GPU is available in the system
+     * @return true if an Intel GPU was detected and initialized, false otherwise
+     */
+    bool is_available() const override;
+
+    /**
+     * @brief Get information about all Intel GPUs in the system
+     * @return Vector of GPUInfo structures containing information about each GPU
+     *
+     * RC6 residency and power are averaged since the previous call; the first call
+     * samples the counters twice, 100ms apart. Utilization is the time outside RC6.
+     * Neither driver exports device memory usage in sysfs, so memory is left at 0.
+     */
+    std::vector<GPUInfo> get_gpu_info() const override;
+
+    /**
+     * @brief Get GPU usage information for a specific process
+     * @param process_name Name of the process to monitor
+     * @return Optional vector of GPUProcessInfo structures, or nullopt if process not found
+     *
+     * Engine busy percentages and memory come from DRM fdinfo; overall usage is the
+     * busiest engine.
+     */
+    std::optional<std::vector<GPUProcessInfo>> get_process_info(const std::string& process_name) const override;
+
+    /**
+     * @brief Get GPU usage information for a process by PID
+     * @param pid Process ID to monitor
+     * @return Optional vector of GPUProcessInfo structures, or nullopt if process not found
+     */
+    std::optional<std::vector<GPUProcessInfo>> get_process_info(uint32_t pid) const override;
+
+    /**
+     * @brief Get information about a specific GPU by index
+     * @param gpu_index Index of the GPU to query
+     * @return Optional GPUInfo structure, or nullopt if GPU not found
+     */
+    std::optional<GPUInfo> get_gpu_info(uint32_t gpu_index) const override;
+};
+
+} // namespace hw_monitor
@@ -5,6 +5,7 @@
 #include <optional>
 #include <memory>
 #include <cstdint>
+#include <array>
 
 namespace hw_monitor {
 
@@ -18,6 +19,8 @@ struct NetworkProcessInfo {
     float transmit_bytes_per_sec;           ///< Network transmit rate in bytes per second
     uint32_t active_connections;            ///< Number of active network connections
     std::vector<uint16_t> ports;            ///< List of ports being used by the process
+    uint64_t receive_queue_bytes;           ///< Unread bytes queued on the process's sockets (Recv-Q)
+    uint64_t send_queue_bytes;              ///< Unsent or unacknowledged bytes on the process's sockets (Send-Q)
 };
 
 /**
@@ -36,6 +39,364 @@ struct NetworkInterfaceInfo {
     float link_speed_mbps;                  ///< Link speed in Megabits per second (if available)
 };
 
+/**
+ * @brief Health metrics of a single TCP connection (from sock_diag tcp_info)
+ */
+struct TCPConnectionInfo {
+    std::string local_address;              ///< Local IP address
+    uint16_t local_port;                    ///< Local port
+    std::string remote_address;             ///< Remote IP address
+    uint16_t remote_port;                   ///< Remote port
+    uint32_t pid;                           ///< Owning process ID (0 if the owner could not be resolved)
+    std::string process_name;               ///< Name of the owning process
+    float rtt_ms;                           ///< Smoothed round-trip time in milliseconds
+    float rtt_var_ms;                       ///< Round-trip time variance in milliseconds
+    uint32_t retransmits;                   ///< Total retransmitted segments over the connection lifetime
+    uint32_t lost;                          ///< Segments currently considered lost
+    uint32_t congestion_window;             ///< Sender congestion window in segments
+    uint64_t delivery_rate_bytes_per_sec;   ///< Most recent delivery rate estimate in bytes per second
+    uint64_t busy_time_us;                  ///< Time spent actively sending data in microseconds
+    uint64_t rwnd_limited_us;               ///< Time sending was limited by the peer's receive window
+    uint64_t sndbuf_limited_us;             ///< Time sending was limited by the local send buffer
+};
+
+/**
+ * @brief TCP health metrics aggregated over a group of connections
+ */
+struct TCPHealthSummary {
+    std::string key;                        ///< Group key (process name or remote subnet in CIDR notation)
+    uint32_t pid;                           ///< Process ID for per-process summaries, 0 otherwise
+    uint32_t connection_count;              ///< Number of connections in the group
+    float average_rtt_ms;                   ///< Mean smoothed RTT across connections
+    float max_rtt_ms;                       ///< Worst smoothed RTT across connections
+    float average_rtt_var_ms;               ///< Mean RTT variance across connections
+    uint64_t total_retransmits;             ///< Sum of lifetime retransmits
+    uint64_t total_lost;                    ///< Sum of segments currently considered lost
+    uint64_t total_delivery_rate_bytes_per_sec; ///< Sum of delivery rate estimates
+    uint64_t busy_time_us;                  ///< Sum of busy sending time
+    uint64_t rwnd_limited_us;               ///< Sum of receive-window-limited time
+    uint64_t sndbuf_limited_us;             ///< Sum of send-buffer-limited time
+};
+
+/**
+ * @brief System-wide TCP counters from /proc/net/snmp and /proc/net/netstat
+ */
+struct TCPStackCounters {
+    uint64_t retrans_segs;                  ///< Tcp: RetransSegs
+    uint64_t in_errs;                       ///< Tcp: InErrs
+    uint64_t out_rsts;                      ///< Tcp: OutRsts
+    uint64_t listen_overflows;              ///< TcpExt: ListenOverflows
+    uint64_t listen_drops;                  ///< TcpExt: ListenDrops
+    uint64_t tcp_timeouts;                  ///< TcpExt: TCPTimeouts
+    uint64_t lost_retransmits;              ///< TcpExt: TCPLostRetransmit
+    uint64_t fast_retransmits;              ///< TcpExt: TCPFastRetrans
+    uint64_t slow_start_retransmits;        ///< TcpExt: TCPSlowStartRetrans
+    uint64_t syn_retransmits;               ///< TcpExt: TCPSynRetrans
+    uint64_t backlog_drops;                 ///< TcpExt: TCPBacklogDrop
+};
+
+/**
+ * @brief Snapshot of TCP connection health
+ */
+struct TCPHealthReport {
+    std::vector<TCPConnectionInfo> connections;     ///< Per-connection metrics
+    std::vector<TCPHealthSummary> by_process;       ///< Metrics aggregated per owning process
+    std::vector<TCPHealthSummary> by_remote_subnet; ///< Metrics aggregated per remote /24 (IPv4) or /64 (IPv6)
+    TCPStackCounters counters;                      ///< System-wide TCP counters
+};
+
+/**
+ * @brief Accept-queue state of a listening TCP socket
+ */
+struct ListenSocketInfo {
+    std::string address;                    ///< Local address the socket listens on
+    uint16_t port;                          ///< Local port the socket listens on
+    uint32_t pid;                           ///< Owning process ID (0 if the owner could not be resolved)
+    std::string process_name;               ///< Name of the owning process
+    uint32_t accept_queue_depth;            ///< Connections waiting to be accepted
+    uint32_t backlog;                       ///< Configured accept backlog
+    float fill_percent;                     ///< Accept queue depth relative to the backlog (0-100)
+    uint32_t saturated_samples;             ///< Consecutive samples with the queue above the threshold
+    bool alert;                             ///< Queue stayed above the threshold for the required number of samples
+};
+
+/**
+ * @brief Accept-queue saturation snapshot for all listening sockets
+ */
+struct ListenQueueReport {
+    std::vector<ListenSocketInfo> listeners;    ///< Per-listener accept queue state
+    uint64_t listen_overflows;                  ///< TcpExt: ListenOverflows total
+    uint64_t listen_drops;                      ///< TcpExt: ListenDrops total
+    float listen_overflows_per_sec;             ///< Rate of accept queue overflows
+    float listen_drops_per_sec;                 ///< Rate of SYNs dropped by listeners
+};
+
+/**
+ * @brief Queue occupancy of a single socket
+ */
+struct SocketQueueInfo {
+    std::string protocol;                   ///< Transport protocol ("tcp" or "udp")
+    std::string local_address;              ///< Local IP address
+    uint16_t local_port;                    ///< Local port
+    std::string remote_address;             ///< Remote IP address
+    uint16_t remote_port;                   ///< Remote port
+    uint32_t receive_queue_bytes;           ///< Bytes received but not yet read by the application (Recv-Q)
+    uint32_t send_queue_bytes;              ///< Bytes not yet sent or acknowledged (Send-Q)
+};
+
+/**
+ * @brief Socket queue occupancy summed over a process
+ */
+struct ProcessSocketQueueInfo {
+    uint32_t pid;                           ///< Process ID
+    std::string process_name;               ///< Name of the process
+    uint32_t socket_count;                  ///< Number of sockets considered
+    uint64_t receive_queue_bytes;           ///< Sum of Recv-Q over all sockets
+    uint64_t send_queue_bytes;              ///< Sum of Send-Q over all sockets
+    std::vector<SocketQueueInfo> sockets;   ///< Per-socket queue occupancy
+};
+
+/**
+ * @brief System-wide socket memory usage from /proc/net/sockstat
+ */
+struct SocketMemoryInfo {
+    uint32_t sockets_used;                  ///< Total sockets allocated
+    uint32_t tcp_in_use;                    ///< TCP sockets in use
+    uint32_t tcp_orphaned;                  ///< TCP sockets no longer attached to a process
+    uint32_t tcp_time_wait;                 ///< TCP sockets in TIME_WAIT
+    uint32_t tcp_allocated;                 ///< TCP sockets allocated
+    uint64_t tcp_memory_bytes;              ///< Memory used by TCP socket buffers
+    uint32_t udp_in_use;                    ///< UDP sockets in use
+    uint64_t udp_memory_bytes;              ///< Memory used by UDP socket buffers
+};
+
+/**
+ * @brief Socket buffer occupancy snapshot
+ */
+struct SocketBufferReport {
+    std::vector<ProcessSocketQueueInfo> processes;  ///< Per-process occupancy, largest Recv-Q first
+    SocketMemoryInfo memory;                        ///< System-wide socket memory totals
+};
+
+/**
+ * @brief Statistics of a single NIC receive or transmit queue
+ */
+struct NICQueueInfo {
+    std::string interface;                  ///< Interface the queue belongs to
+    std::string queue;                      ///< Queue name as in sysfs (e.g., rx-0, tx-3)
+    bool is_rx;                             ///< Whether this is a receive queue
+    std::string cpu_mask;                   ///< RPS (rx) or XPS (tx) CPU mask, empty if not exposed
+    bool has_counters;                      ///< Whether the driver exposes per-queue counters
+    uint64_t bytes;                         ///< Total bytes handled by the queue
+    uint64_t packets;                       ///< Total packets handled by the queue
+    float bytes_per_sec;                    ///< Current byte rate
+    float packets_per_sec;                  ///< Current packet rate
+};
+
+/**
+ * @brief Per-CPU packet processing statistics from /proc/net/softnet_stat
+ */
+struct SoftnetCPUStats {
+    uint32_t cpu;                           ///< CPU index
+    uint64_t processed;                     ///< Packets processed by the CPU's backlog/NAPI loop
+    uint64_t dropped;                       ///< Packets dropped because the backlog queue was full
+    uint64_t time_squeeze;                  ///< Times net_rx_action ran out of budget or time with work left
+    uint64_t received_rps;                  ///< Times the CPU was woken up to process packets via RPS
+    uint64_t flow_limit_count;              ///< Times the flow limit was reached
+    float processed_per_sec;                ///< Rate of processed packets
+    float dropped_per_sec;                  ///< Rate of dropped packets
+    float time_squeeze_per_sec;             ///< Rate of time squeezes
+    float received_rps_per_sec;             ///< Rate of RPS wakeups
+};
+
+/**
+ * @brief TCP socket as seen from inside a network namespace
+ */
+struct NamespaceSocketInfo {
+    std::string local_address;              ///< Local IP address
+    uint16_t local_port;                    ///< Local port
+    std::string remote_address;             ///< Remote IP address
+    uint16_t remote_port;                   ///< Remote port
+    std::string state;                      ///< TCP state name (e.g., ESTABLISHED, LISTEN)
+    uint32_t pid;                           ///< Owning process ID (0 if the owner could not be resolved)
+    std::string process_name;               ///< Name of the owning process
+};
+
+/**
+ * @brief Interfaces and sockets of a single network namespace
+ */
+struct NetworkNamespaceInfo {
+    uint64_t inode;                                 ///< Namespace identifier (inode of /proc/[pid]/ns/net)
+    bool is_own_namespace;                          ///< Whether this is the namespace of the monitoring process
+    std::vector<uint32_t> pids;                     ///< Processes living in the namespace
+    std::vector<NetworkInterfaceInfo> interfaces;   ///< Interfaces with byte totals and rates (sysfs attributes only for the own namespace)
+    std::vector<NamespaceSocketInfo> sockets;       ///< TCP sockets of the namespace
+};
+
+/**
+ * @brief Per-CPU connection tracking statistics from /proc/net/stat/nf_conntrack
+ */
+struct ConntrackCPUStats {
+    uint32_t cpu;                           ///< CPU index
+    uint64_t insert_failed;                 ///< Entries that could not be inserted into the table
+    uint64_t drop;                          ///< Packets dropped because no entry could be created
+    uint64_t early_drop;                    ///< Entries evicted to make room when the table was full
+    uint64_t search_restart;                ///< Lookups restarted due to concurrent table resizes
+    float insert_failed_per_sec;            ///< Rate of failed inserts
+    float drop_per_sec;                     ///< Rate of drops
+    float early_drop_per_sec;               ///< Rate of early drops
+    float search_restart_per_sec;           ///< Rate of search restarts
+};
+
+/**
+ * @brief Connection tracking table utilization
+ */
+struct ConntrackInfo {
+    uint64_t count;                         ///< Current number of tracked connections
+    uint64_t max;                           ///< Table capacity (nf_conntrack_max)
+    float usage_percent;                    ///< Table fill level (0-100)
+    bool near_capacity;                     ///< Whether the fill level is above the warning threshold
+    float insert_failed_per_sec;            ///< Rate of failed inserts summed over CPUs
+    float drop_per_sec;                     ///< Rate of drops summed over CPUs
+    float early_drop_per_sec;               ///< Rate of early drops summed over CPUs
+    float search_restart_per_sec;           ///< Rate of search restarts summed over CPUs
+    std::vector<ConntrackCPUStats> per_cpu; ///< Per-CPU statistics
+};
+
+/**
+ * @brief Traffic-control statistics of a queueing discipline or class
+ */
+struct QdiscInfo {
+    std::string interface;                  ///< Interface the qdisc is attached to
+    std::string kind;                       ///< Qdisc type (e.g., fq_codel, htb, mq)
+    std::string handle;                     ///< Handle in tc notation (e.g., 1:0)
+    std::string parent;                     ///< Parent handle in tc notation, "root" or "ingress"
+    bool is_class;                          ///< Whether this entry is a class rather than a qdisc
+    uint64_t bytes;                         ///< Total bytes dequeued
+    uint64_t packets;                       ///< Total packets dequeued; wraps at 2^32 on kernels without TCA_STATS_PKT64
+    uint32_t drops;                         ///< Total packets dropped
+    uint32_t overlimits;                    ///< Total times the rate limit was exceeded
+    uint32_t requeues;                      ///< Total packets requeued
+    uint32_t backlog_bytes;                 ///< Bytes currently queued
+    uint32_t queue_length;                  ///< Packets currently queued
+    float bytes_per_sec;                    ///< Current byte rate
+    float packets_per_sec;                  ///< Current packet rate
+    float drops_per_sec;                    ///< Current drop rate
+    float overlimits_per_sec;               ///< Current overlimit rate
+    float requeues_per_sec;                 ///< Current requeue rate
+};
+
+/**
+ * @brief Count of TCP sockets in the states that reveal connection churn and leaks
+ */
+struct TCPStateCounts {
+    uint32_t time_wait;                     ///< Sockets in TIME_WAIT
+    uint32_t close_wait;                    ///< Sockets in CLOSE_WAIT (peer closed, application has not)
+    uint32_t syn_recv;                      ///< Half-open connections in SYN_RECV
+};
+
+/**
+ * @brief Per-process TCP state counts
+ */
+struct ProcessTCPStateInfo {
+    uint32_t pid;                           ///< Process ID
+    std::string process_name;               ///< Name of the process
+    uint32_t close_wait;                    ///< CLOSE_WAIT sockets owned by the process
+    uint32_t syn_recv;                      ///< SYN_RECV connections pending on the process's listeners
+    int32_t close_wait_delta;               ///< Change of close_wait since the previous call
+    bool close_wait_leak_suspected;         ///< CLOSE_WAIT count is above the threshold and not shrinking
+};
+
+/**
+ * @brief TCP connection churn rates and state distribution
+ */
+struct TCPChurnReport {
+    float active_opens_per_sec;             ///< Outgoing connections initiated (Tcp: ActiveOpens)
+    float passive_opens_per_sec;            ///< Incoming connections accepted (Tcp: PassiveOpens)
+    float attempt_fails_per_sec;            ///< Connection attempts that failed (Tcp: AttemptFails)
+    float estab_resets_per_sec;             ///< Established connections reset to CLOSED (Tcp: EstabResets)
+    float out_rsts_per_sec;                 ///< Resets sent (Tcp: OutRsts)
+    uint64_t current_established;           ///< Connections currently established (Tcp: CurrEstab)
+    TCPStateCounts system;                  ///< System-wide state counts
+    std::vector<ProcessTCPStateInfo> processes; ///< Per-process state counts, largest CLOSE_WAIT first
+};
+
+/**
+ * @brief Grouping of remote endpoints for top-talker reports
+ */
+enum class TalkerGrouping {
+    RemoteAddress,                          ///< Group by remote IP address
+    RemoteSubnet,                           ///< Group by remote /24 (IPv4) or /64 (IPv6)
+    RemotePort                              ///< Group by remote port
+};
+
+/**
+ * @brief Throughput exchanged with a remote peer (address, subnet or port)
+ */
+struct TopTalkerInfo {
+    std::string peer;                       ///< Peer key (address, subnet in CIDR notation or port)
+    float receive_bytes_per_sec;            ///< Bytes received from the peer per second
+    float transmit_bytes_per_sec;           ///< Bytes acknowledged by the peer per second
+    float total_bytes_per_sec;              ///< Total throughput estimate as ranked by the sketch
+    float error_bytes_per_sec;              ///< Upper bound on the overestimation of total_bytes_per_sec
+    uint32_t connection_count;              ///< Connections that contributed to the peer
+    std::vector<uint32_t> pids;             ///< Local processes talking to the peer
+    std::vector<std::string> process_names; ///< Names of the local processes, parallel to pids
+};
+
+/**
+ * @brief Position of an interface in the bond/VLAN/bridge/veth stacking topology
+ */
+struct InterfaceTopologyInfo {
+    std::string name;                       ///< Interface name
+    std::string kind;                       ///< Device type (e.g., bond, vlan, bridge, veth, or the NIC driver name)
+    bool is_physical;                       ///< Whether the interface is backed by a hardware device
+    std::string master;                     ///< Bond or bridge this interface is enslaved to, empty if none
+    std::vector<std::string> lower_devices; ///< Devices this interface is stacked on (e.g., VLAN parent, bond slaves)
+    std::vector<std::string> upper_devices; ///< Devices stacked on top of this interface
+    float receive_bytes_per_sec;            ///< Current receive rate in bytes per second
+    float transmit_bytes_per_sec;           ///< Current transmit rate in bytes per second
+};
+
+/**
+ * @brief Interface traffic rolled up without double-counting stacked devices
+ */
+struct NetworkTrafficSummary {
+    std::vector<InterfaceTopologyInfo> interfaces;  ///< Topology and rates of every interface
+    float physical_receive_bytes_per_sec;           ///< Receive rate summed over physical uplinks
+    float physical_transmit_bytes_per_sec;          ///< Transmit rate summed over physical uplinks
+    float virtual_receive_bytes_per_sec;            ///< Receive rate summed over top-level virtual interfaces
+    float virtual_transmit_bytes_per_sec;           ///< Transmit rate summed over top-level virtual interfaces
+};
+
+/**
+ * @brief Short-timescale utilization of an interface recorded by the microburst monitor
+ */
+struct MicroburstInfo {
+    std::string interface;                  ///< Interface name
+    float link_speed_mbps;                  ///< Link speed used as the utilization reference
+    uint32_t sample_interval_us;            ///< Sampling interval in use, in microseconds (at least 100)
+    uint64_t samples;                       ///< Samples taken since the previous report
+    float peak_utilization_percent;         ///< Highest single-sample utilization of the busier direction
+    float peak_receive_mbps;                ///< Highest single-sample receive rate in Megabits per second
+    float peak_transmit_mbps;               ///< Highest single-sample transmit rate in Megabits per second
+    uint32_t burst_count;                   ///< Bursts (runs of consecutive samples above the burst threshold)
+    std::array<uint32_t, 11> utilization_histogram; ///< Samples per 10% utilization bucket, last bucket is >= 100%
+};
+
+/**
+ * @brief Communication link between two local processes
+ */
+struct ProcessCommunicationEdge {
+    uint32_t pid_a;                         ///< First process ID (the lower of the two)
+    std::string process_name_a;             ///< Name of the first process
+    uint32_t pid_b;                         ///< Second process ID
+    std::string process_name_b;             ///< Name of the second process
+    std::string transport;                  ///< "unix" for UNIX domain sockets, "tcp" for loopback TCP
+    uint32_t connection_count;              ///< Number of socket pairs between the two processes
+    float bytes_per_sec;                    ///< Traffic in both directions (loopback TCP only, 0 for UNIX sockets)
+};
+
 /**
  * @brief Network interface and process monitoring
  * 
@@ -80,6 +441,145 @@ public:
      */
     std::vector<std::string> get_interface_names() const;
 
+    /**
+     * @brief Get TCP connection health metrics
+     *
+     * Uses a single sock_diag dump to collect tcp_info for every connection and
+     * aggregates it per process and per remote subnet.
+     * @return Per-connection metrics, aggregates and system-wide TCP counters
+     */
+    TCPHealthReport get_tcp_health() const;
+
+    /**
+     * @brief Get accept-queue saturation of listening TCP sockets
+     *
+     * A listener raises an alert once its queue has stayed above the threshold
+     * for the given number of consecutive calls.
+     * @param threshold_percent Queue fill level (percentage of backlog) considered saturated
+     * @param sustained_samples Number of consecutive saturated samples before alerting; 0 is treated as 1
+     * @return Per-listener queue state and system-wide overflow rates
+     */
+    ListenQueueReport get_listen_queue_info(float threshold_percent = 80.0f, uint32_t sustained_samples = 3) const;
+
+    /**
+     * @brief Get socket buffer occupancy per process
+     *
+     * Covers established TCP sockets and UDP sockets. A process whose Recv-Q keeps
+     * growing is not keeping up with its input.
+     * @return Per-process queue occupancy and system-wide socket memory totals
+     */
+    SocketBufferReport get_socket_buffer_info() const;
+
+    /**
+     * @brief Get per-queue statistics for all network interfaces
+     *
+     * Byte and packet counters come from the driver's ethtool statistics when it
+     * exposes per-queue values; RPS/XPS masks come from sysfs.
+     * @return Vector of queue information structures
+     */
+    std::vector<NICQueueInfo> get_nic_queue_info() const;
+
+    /**
+     * @brief Get per-CPU packet processing statistics
+     * @return Vector of per-CPU softnet statistics with rates
+     */
+    std::vector<SoftnetCPUStats> get_softnet_stats() const;
+
+    /**
+     * @brief Get interfaces and sockets of every network namespace
+     *
+     * Namespaces are discovered through /proc/[pid]/ns/net and each one is read
+     * once per sample through a single representative process.
+     * @return Vector of namespace information structures
+     */
+    std::vector<NetworkNamespaceInfo> get_namespace_info() const;
+
+    /**
+     * @brief Get connection tracking table utilization
+     * @param warn_percent Fill level (percentage of nf_conntrack_max) that flags the table as near capacity
+     * @return Conntrack information if the nf_conntrack module is loaded
+     */
+    std::optional<ConntrackInfo> get_conntrack_info(float warn_percent = 90.0f) const;
+
+    /**
+     * @brief Get traffic-control qdisc and class statistics
+     *
+     * Uses RTM_GETQDISC and RTM_GETTCLASS netlink dumps for the interfaces
+     * returned by get_interface_names(). Egress queueing drops are not visible
+     * in the /proc/net/dev counters.
+     * @return Vector of qdisc and class statistics with rates
+     */
+    std::vector<QdiscInfo> get_qdisc_info() const;
+
+    /**
+     * @brief Get TCP connection churn and per-state socket counts
+     *
+     * TIME_WAIT sockets no longer belong to a process and are only counted
+     * system-wide; SYN_RECV connections are attributed to the owner of the
+     * matching listener.
+     * @param close_wait_threshold Per-process CLOSE_WAIT count above which a leak is suspected
+     * @return Churn rates, system-wide and per-process state counts
+     */
+    TCPChurnReport get_tcp_churn(uint32_t close_wait_threshold = 32) const;
+
+    /**
+     * @brief Get the remote peers exchanging the most TCP traffic
+     *
+     * Per-socket byte deltas from tcp_info are fed into a Space-Saving heavy-hitter
+     * sketch, so memory stays bounded by sketch_capacity regardless of the number
+     * of peers.
+     * @param grouping How remote endpoints are grouped
+     * @param limit Maximum number of peers to return
+     * @param sketch_capacity Number of peers tracked by the sketch
+     * @return Peers sorted by throughput, highest first
+     */
+    std::vector<TopTalkerInfo> get_top_talkers(TalkerGrouping grouping = TalkerGrouping::RemoteAddress,
+                                               size_t limit = 10, size_t sketch_capacity = 1024) const;
+
+    /**
+     * @brief Get interface stacking topology and traffic totals
+     *
+     * Bond slaves, VLAN sub-interfaces, bridges and veths carry the same packets
+     * more than once, so physical-uplink totals are reported separately from
+     * virtual-interface totals.
+     * @return Per-interface topology with rates and rolled-up totals
+     */
+    NetworkTrafficSummary get_traffic_summary() const;
+
+    /**
+     * @brief Start high-frequency sampling of interface byte counters on a dedicated thread
+     *
+     * Counters are read from /sys/class/net/<if>/statistics/{rx,tx}_bytes through
+     * descriptors kept open for the lifetime of the monitor. Results are only as
+     * fine-grained as the driver updates these counters.
+     * @param interfaces Interfaces to sample (typically a few uplinks)
+     * @param sample_interval_us Sampling interval in microseconds (1000-10000 recommended, at least 100)
+     * @param burst_threshold_percent Utilization above which a sample counts towards a burst
+     * @return true if the monitor is running for at least one interface
+     */
+    bool start_microburst_monitor(const std::vector<std::string>& interfaces, uint32_t sample_interval_us = 1000,
+                                  float burst_threshold_percent = 80.0f);
+
+    /**
+     * @brief Stop the microburst monitor thread
+     */
+    void stop_microburst_monitor();
+
+    /**
+     * @brief Get microburst statistics accumulated since the previous call
+     * @return Per-interface peak utilization, burst count and utilization histogram
+     */
+    std::vector<MicroburstInfo> get_microburst_info() const;
+
+    /**
+     * @brief Get the graph of local processes talking to each other
+     *
+     * UNIX sockets are paired through their peer inode, loopback TCP connections
+     * through matching local and remote endpoints.
+     * @return Edges between process pairs, busiest first
+     */
+    std::vector<ProcessCommunicationEdge> get_process_communication_graph() const;
+
 private:
     class Impl;                             ///< Forward declaration
     std::unique_ptr<Impl> pimpl_;           ///< Pointer to implementation
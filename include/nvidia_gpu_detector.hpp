@@ -5,7 +5,12 @@
 #include <map>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <chrono>
+#include <mutex>
+#include <functional>
+#include <thread>
+#include <atomic>
 
 #ifdef __linux__
 #include <dlfcn.h>
@@ -19,9 +24,24 @@
 /// Opaque handle to a device
 typedef struct nvmlDevice_st* nvmlDevice_t;
 
+/// Buffer size for the legacy PCI bus ID string
+#define NVML_DEVICE_PCI_BUS_ID_BUFFER_V2_SIZE 16
+
+/// Buffer size for the PCI bus ID string
+#define NVML_DEVICE_PCI_BUS_ID_BUFFER_SIZE 32
+
+/// Buffer size for the device UUID string
+#define NVML_DEVICE_UUID_V2_BUFFER_SIZE 96
+
 /// PCI information structure
 typedef struct {
-    unsigned long long reserved[8];             ///< Reserved for future use
+    char busIdLegacy[NVML_DEVICE_PCI_BUS_ID_BUFFER_V2_SIZE];   ///< Legacy "domain:bus:device.function" bus ID
+    unsigned int domain;                        ///< PCI domain
+    unsigned int bus;                           ///< PCI bus
+    unsigned int device;                        ///< PCI device
+    unsigned int pciDeviceId;                   ///< Combined 16-bit device ID and 16-bit vendor ID
+    unsigned int pciSubSystemId;                ///< 32-bit sub system device ID
+    char busId[NVML_DEVICE_PCI_BUS_ID_BUFFER_SIZE];            ///< "domain:bus:device.function" bus ID
 } nvmlPciInfo_t;
 
 /// GPU utilization information
@@ -37,10 +57,18 @@ typedef struct {
     unsigned long long used;                    ///< Allocated memory
 } nvmlMemory_t;
 
-/// Process information structure
+/// Process information structure used by the original, unversioned process queries
+typedef struct {
+    unsigned int pid;                           ///< Process ID
+    unsigned long long usedGpuMemory;           ///< GPU memory used by process in bytes
+} nvmlProcessInfo_v1_t;
+
+/// Process information structure used by the _v2 and _v3 process queries
 typedef struct {
     unsigned int pid;                           ///< Process ID
     unsigned long long usedGpuMemory;           ///< GPU memory used by process in bytes
+    unsigned int gpuInstanceId;                 ///< MIG GPU instance ID (0xFFFFFFFF if not in MIG mode)
+    unsigned int computeInstanceId;             ///< MIG compute instance ID (0xFFFFFFFF if not in MIG mode)
 } nvmlProcessInfo_t;
 
 /// Process utilization sample
@@ -86,6 +114,111 @@ typedef enum nvmlTemperatureSensors_enum {
     NVML_TEMPERATURE_GPU = 0                    ///< GPU core temperature
 } nvmlTemperatureSensors_t;
 
+/// Clock domains
+typedef enum nvmlClockType_enum {
+    NVML_CLOCK_GRAPHICS = 0,                    ///< Graphics clock domain
+    NVML_CLOCK_SM = 1,                          ///< SM clock domain
+    NVML_CLOCK_MEM = 2,                         ///< Memory clock domain
+    NVML_CLOCK_VIDEO = 3                        ///< Video encoder/decoder clock domain
+} nvmlClockType_t;
+
+/// PCIe throughput counters
+typedef enum nvmlPcieUtilCounter_enum {
+    NVML_PCIE_UTIL_TX_BYTES = 0,                ///< Transmitted bytes
+    NVML_PCIE_UTIL_RX_BYTES = 1                 ///< Received bytes
+} nvmlPcieUtilCounter_t;
+
+/// Performance states, P0 (maximum performance) to P15 (minimum)
+typedef enum nvmlPStates_enum {
+    NVML_PSTATE_0 = 0,                          ///< Maximum performance
+    NVML_PSTATE_15 = 15,                        ///< Minimum performance
+    NVML_PSTATE_UNKNOWN = 32                    ///< Unknown performance state
+} nvmlPstates_t;
+
+/// ECC error types
+typedef enum nvmlMemoryErrorType_enum {
+    NVML_MEMORY_ERROR_TYPE_CORRECTED = 0,       ///< Errors corrected by ECC
+    NVML_MEMORY_ERROR_TYPE_UNCORRECTED = 1      ///< Errors not correctable by ECC
+} nvmlMemoryErrorType_t;
+
+/// ECC counter lifetimes
+typedef enum nvmlEccCounterType_enum {
+    NVML_VOLATILE_ECC = 0,                      ///< Reset on driver reload
+    NVML_AGGREGATE_ECC = 1                      ///< Persistent across reboots
+} nvmlEccCounterType_t;
+
+/// Sample history types for nvmlDeviceGetSamples
+typedef enum nvmlSamplingType_enum {
+    NVML_TOTAL_POWER_SAMPLES = 0,               ///< Power draw in milliwatts
+    NVML_GPU_UTILIZATION_SAMPLES = 1,           ///< GPU utilization percent
+    NVML_MEMORY_UTILIZATION_SAMPLES = 2,        ///< Memory utilization percent
+    NVML_ENC_UTILIZATION_SAMPLES = 3,           ///< Encoder utilization percent
+    NVML_DEC_UTILIZATION_SAMPLES = 4,           ///< Decoder utilization percent
+    NVML_PROCESSOR_CLK_SAMPLES = 5,             ///< Processor clock in MHz
+    NVML_MEMORY_CLK_SAMPLES = 6,                ///< Memory clock in MHz
+    NVML_SAMPLINGTYPE_COUNT                     ///< Number of sample types
+} nvmlSamplingType_t;
+
+/// Type of the value held in an nvmlValue_t
+typedef enum nvmlValueType_enum {
+    NVML_VALUE_TYPE_DOUBLE = 0,
+    NVML_VALUE_TYPE_UNSIGNED_INT = 1,
+    NVML_VALUE_TYPE_UNSIGNED_LONG = 2,
+    NVML_VALUE_TYPE_UNSIGNED_LONG_LONG = 3,
+    NVML_VALUE_TYPE_SIGNED_LONG_LONG = 4
+} nvmlValueType_t;
+
+/// Sample value, interpreted according to nvmlValueType_t
+typedef union {
+    double dVal;
+    unsigned int uiVal;
+    unsigned long ulVal;
+    unsigned long long ullVal;
+    signed long long sllVal;
+} nvmlValue_t;
+
+/// Timestamped sample from the driver's sample history
+typedef struct {
+    unsigned long long timeStamp;               ///< CPU timestamp in microseconds
+    nvmlValue_t sampleValue;                    ///< Sample value
+} nvmlSample_t;
+
+/// Feature enable state
+typedef enum nvmlEnableState_enum {
+    NVML_FEATURE_DISABLED = 0,                  ///< Feature disabled
+    NVML_FEATURE_ENABLED = 1                    ///< Feature enabled
+} nvmlEnableState_t;
+
+/// Accounting statistics of a process
+typedef struct {
+    unsigned int gpuUtilization;                ///< Average GPU utilization percent over the process lifetime
+    unsigned int memoryUtilization;             ///< Average memory utilization percent over the process lifetime
+    unsigned long long maxMemoryUsage;          ///< Peak memory usage in bytes
+    unsigned long long time;                    ///< Run time in milliseconds
+    unsigned long long startTime;               ///< Start time, microseconds since the Unix epoch
+    unsigned int isRunning;                     ///< 1 while the process runs, 0 after it exited
+    unsigned int reserved[5];                   ///< Reserved for future use
+} nvmlAccountingStats_t;
+
+/// Opaque handle to an event set
+typedef struct nvmlEventSet_st* nvmlEventSet_t;
+
+/// Event delivered by nvmlEventSetWait_v2
+typedef struct {
+    nvmlDevice_t device;                        ///< Device that raised the event
+    unsigned long long eventType;               ///< Event type (one of the nvmlEventType* bits)
+    unsigned long long eventData;               ///< Event payload (XID code for XID errors)
+    unsigned int gpuInstanceId;                 ///< MIG GPU instance ID
+    unsigned int computeInstanceId;             ///< MIG compute instance ID
+} nvmlEventData_t;
+
+/// Event type bits
+#define nvmlEventTypeSingleBitEccError 0x0000000000000001LL     ///< Corrected ECC error
+#define nvmlEventTypeDoubleBitEccError 0x0000000000000002LL     ///< Uncorrectable ECC error
+#define nvmlEventTypePState 0x0000000000000004LL                ///< Performance state change
+#define nvmlEventTypeXidCriticalError 0x0000000000000008LL      ///< Critical XID error
+#define nvmlEventTypeClock 0x0000000000000010LL                 ///< Clock change
+
 /// Maximum length of device name string
 #define NVML_DEVICE_NAME_BUFFER_SIZE 64
 
@@ -117,10 +250,65 @@ public:
     std::optional<std::vector<GPUProcessInfo>> get_process_info(const std::string& process_name) const override;
     std::optional<std::vector<GPUProcessInfo>> get_process_info(uint32_t pid) const override;
     std::optional<GPUInfo> get_gpu_info(uint32_t gpu_index) const override;
+    std::vector<GPUSampleStats> get_sample_stats() const override;
+    std::vector<GPUAccountingInfo> get_accounting_info() const override;
+    bool start_event_listener(GPUEventCallback callback) override;
+    void stop_event_listener() override;
 
 private:
+    /**
+     * @brief Per-device state resolved once at initialization
+     */
+    struct DeviceCache {
+        nvmlDevice_t handle;                    ///< NVML device handle
+        uint32_t index;                         ///< NVML device index
+        std::string name;                       ///< Device name
+        std::string uuid;                       ///< Device UUID
+        std::string pci_bus_id;                 ///< PCI bus ID
+        float total_memory_mb;                  ///< Total memory in megabytes
+        mutable unsigned long long last_seen_timestamp; ///< Newest process utilization sample already consumed (0 = never polled)
+        mutable uint32_t unsupported_telemetry; ///< TelemetryField bits the device reported as not supported
+        mutable std::array<unsigned long long, NVML_SAMPLINGTYPE_COUNT> history_last_seen; ///< Newest history sample consumed per sample type
+        mutable uint32_t unsupported_history;   ///< Bits (1 << nvmlSamplingType_t) the device reported as not supported
+        mutable std::unordered_set<unsigned int> finalized_pids;            ///< Exited processes already reported
+        mutable std::unordered_map<unsigned int, std::string> running_names; ///< Names of running processes, kept for after they exit
+    };
+
+    /**
+     * @brief Extended telemetry queries, as bits of DeviceCache::unsupported_telemetry
+     */
+    enum TelemetryField : uint32_t {
+        TELEMETRY_POWER_DRAW = 1u << 0,
+        TELEMETRY_POWER_LIMIT = 1u << 1,
+        TELEMETRY_SM_CLOCK = 1u << 2,
+        TELEMETRY_MEMORY_CLOCK = 1u << 3,
+        TELEMETRY_GRAPHICS_CLOCK = 1u << 4,
+        TELEMETRY_PCIE_TX = 1u << 5,
+        TELEMETRY_PCIE_RX = 1u << 6,
+        TELEMETRY_ENCODER = 1u << 7,
+        TELEMETRY_DECODER = 1u << 8,
+        TELEMETRY_FAN_SPEED = 1u << 9,
+        TELEMETRY_PERFORMANCE_STATE = 1u << 10,
+        TELEMETRY_THROTTLE_REASONS = 1u << 11,
+        TELEMETRY_ECC_CORRECTED = 1u << 12,
+        TELEMETRY_ECC_UNCORRECTED = 1u << 13
+    };
+
     bool initialized_;                          ///< Whether NVML was successfully initialized
     void* nvml_handle_;                         ///< Handle to the loaded NVML library
+    std::vector<DeviceCache> devices_;          ///< Devices discovered at initialization
+    mutable std::mutex query_mutex_;            ///< Guards the sample timestamps and the reusable query buffers
+
+    // Query buffers reused across calls, grown whenever NVML reports NVML_ERROR_INSUFFICIENT_SIZE
+    mutable std::vector<nvmlProcessInfo_t> process_buffer_;                 ///< Running processes (_v2/_v3 layout)
+    mutable std::vector<nvmlProcessInfo_v1_t> process_buffer_v1_;           ///< Running processes (original layout)
+    mutable std::vector<nvmlProcessUtilizationSample_t> sample_buffer_;     ///< Process utilization samples
+    mutable std::vector<nvmlSample_t> history_buffer_;                      ///< Device sample history
+    mutable std::vector<unsigned int> accounting_pid_buffer_;              ///< PIDs in the accounting buffer
+
+    std::thread event_thread_;                  ///< Event listener thread
+    std::atomic<bool> event_running_{false};    ///< Whether the event listener should keep running
+    nvmlEventSet_t event_set_ = nullptr;        ///< Event set the listener waits on
 
     // Function pointers for dynamic loading
     nvmlReturn_t (*nvmlInit_v2_ptr)();                                                                          ///< Initialize NVML library
@@ -128,14 +316,41 @@ private:
     nvmlReturn_t (*nvmlDeviceGetCount_v2_ptr)(unsigned int*);                                                   ///< Get number of NVIDIA devices
     nvmlReturn_t (*nvmlDeviceGetHandleByIndex_v2_ptr)(unsigned int, nvmlDevice_t*);                             ///< Get handle to GPU at index
     nvmlReturn_t (*nvmlDeviceGetName_ptr)(nvmlDevice_t, char*, unsigned int);                                   ///< Get GPU name
+    nvmlReturn_t (*nvmlDeviceGetUUID_ptr)(nvmlDevice_t, char*, unsigned int);                                   ///< Get GPU UUID
+    nvmlReturn_t (*nvmlDeviceGetPciInfo_v3_ptr)(nvmlDevice_t, nvmlPciInfo_t*);                                  ///< Get PCI information
     nvmlReturn_t (*nvmlDeviceGetMemoryInfo_ptr)(nvmlDevice_t, nvmlMemory_t*);                                   ///< Get memory information
     nvmlReturn_t (*nvmlDeviceGetTemperature_ptr)(nvmlDevice_t, nvmlTemperatureSensors_t, unsigned int*);        ///< Get GPU temperature
     nvmlReturn_t (*nvmlDeviceGetUtilizationRates_ptr)(nvmlDevice_t, nvmlUtilization_t*);                        ///< Get utilization rates
-    nvmlReturn_t (*nvmlDeviceGetComputeRunningProcesses_ptr)(nvmlDevice_t, unsigned int*, nvmlProcessInfo_t*);  ///< Get compute processes
-    nvmlReturn_t (*nvmlDeviceGetGraphicsRunningProcesses_ptr)(nvmlDevice_t, unsigned int*, nvmlProcessInfo_t*); ///< Get graphics processes
+    nvmlReturn_t (*nvmlDeviceGetComputeRunningProcesses_v3_ptr)(nvmlDevice_t, unsigned int*, nvmlProcessInfo_t*);     ///< Get compute processes
+    nvmlReturn_t (*nvmlDeviceGetGraphicsRunningProcesses_v3_ptr)(nvmlDevice_t, unsigned int*, nvmlProcessInfo_t*);    ///< Get graphics processes
+    nvmlReturn_t (*nvmlDeviceGetComputeRunningProcesses_v2_ptr)(nvmlDevice_t, unsigned int*, nvmlProcessInfo_t*);     ///< Get compute processes (older drivers)
+    nvmlReturn_t (*nvmlDeviceGetGraphicsRunningProcesses_v2_ptr)(nvmlDevice_t, unsigned int*, nvmlProcessInfo_t*);    ///< Get graphics processes (older drivers)
+    nvmlReturn_t (*nvmlDeviceGetComputeRunningProcesses_ptr)(nvmlDevice_t, unsigned int*, nvmlProcessInfo_v1_t*);     ///< Get compute processes (legacy drivers)
+    nvmlReturn_t (*nvmlDeviceGetGraphicsRunningProcesses_ptr)(nvmlDevice_t, unsigned int*, nvmlProcessInfo_v1_t*);    ///< Get graphics processes (legacy drivers)
     nvmlReturn_t (*nvmlDeviceGetProcessUtilization_ptr)(nvmlDevice_t device,                                    ///< Get process utilization
         nvmlProcessUtilizationSample_t* utilization, unsigned int* processSamplesCount,
         unsigned long long lastSeenTimeStamp);
+    nvmlReturn_t (*nvmlDeviceGetPowerUsage_ptr)(nvmlDevice_t, unsigned int*);                                  ///< Get power draw in milliwatts
+    nvmlReturn_t (*nvmlDeviceGetEnforcedPowerLimit_ptr)(nvmlDevice_t, unsigned int*);                           ///< Get enforced power limit in milliwatts
+    nvmlReturn_t (*nvmlDeviceGetClockInfo_ptr)(nvmlDevice_t, nvmlClockType_t, unsigned int*);                   ///< Get current clock in MHz
+    nvmlReturn_t (*nvmlDeviceGetPcieThroughput_ptr)(nvmlDevice_t, nvmlPcieUtilCounter_t, unsigned int*);        ///< Get PCIe throughput in KB/s
+    nvmlReturn_t (*nvmlDeviceGetEncoderUtilization_ptr)(nvmlDevice_t, unsigned int*, unsigned int*);            ///< Get encoder utilization
+    nvmlReturn_t (*nvmlDeviceGetDecoderUtilization_ptr)(nvmlDevice_t, unsigned int*, unsigned int*);            ///< Get decoder utilization
+    nvmlReturn_t (*nvmlDeviceGetFanSpeed_ptr)(nvmlDevice_t, unsigned int*);                                     ///< Get fan speed percentage
+    nvmlReturn_t (*nvmlDeviceGetPerformanceState_ptr)(nvmlDevice_t, nvmlPstates_t*);                            ///< Get performance state
+    nvmlReturn_t (*nvmlDeviceGetCurrentClocksThrottleReasons_ptr)(nvmlDevice_t, unsigned long long*);           ///< Get active throttle reasons
+    nvmlReturn_t (*nvmlDeviceGetTotalEccErrors_ptr)(nvmlDevice_t, nvmlMemoryErrorType_t,                        ///< Get ECC error count
+        nvmlEccCounterType_t, unsigned long long*);
+    nvmlReturn_t (*nvmlDeviceGetSamples_ptr)(nvmlDevice_t, nvmlSamplingType_t, unsigned long long,             ///< Get sample history
+        nvmlValueType_t*, unsigned int*, nvmlSample_t*);
+    nvmlReturn_t (*nvmlDeviceGetAccountingMode_ptr)(nvmlDevice_t, nvmlEnableState_t*);                         ///< Get accounting mode
+    nvmlReturn_t (*nvmlDeviceGetAccountingPids_ptr)(nvmlDevice_t, unsigned int*, unsigned int*);                ///< Get PIDs in the accounting buffer
+    nvmlReturn_t (*nvmlDeviceGetAccountingStats_ptr)(nvmlDevice_t, unsigned int, nvmlAccountingStats_t*);       ///< Get accounting stats of a PID
+    nvmlReturn_t (*nvmlEventSetCreate_ptr)(nvmlEventSet_t*);                                                    ///< Create an event set
+    nvmlReturn_t (*nvmlEventSetFree_ptr)(nvmlEventSet_t);                                                       ///< Free an event set
+    nvmlReturn_t (*nvmlDeviceGetSupportedEventTypes_ptr)(nvmlDevice_t, unsigned long long*);                    ///< Get event types a device supports
+    nvmlReturn_t (*nvmlDeviceRegisterEvents_ptr)(nvmlDevice_t, unsigned long long, nvmlEventSet_t);             ///< Register device events in a set
+    nvmlReturn_t (*nvmlEventSetWait_v2_ptr)(nvmlEventSet_t, nvmlEventData_t*, unsigned int);                    ///< Wait for the next event
 
     /**
      * @brief Check if NVIDIA GPU is present in system
@@ -149,6 +364,31 @@ private:
      */
     bool load_functions();
 
+    /**
+     * @brief Resolve handles and static attributes of every device
+     */
+    void cache_devices();
+
+    /**
+     * @brief Poll the dynamic metrics of a cached device
+     * @param device Cached device to query
+     * @return GPU information
+     */
+    GPUInfo build_gpu_info(const DeviceCache& device) const;
+
+    /**
+     * @brief Fill the extended telemetry fields, skipping queries the device does not support
+     * @param device Cached device to query
+     * @param gpu_info GPU information to fill
+     */
+    void read_extended_telemetry(const DeviceCache& device, GPUInfo& gpu_info) const;
+
+    /**
+     * @brief Event listener thread body: wait on the event set and forward events
+     * @param callback Function called for every event
+     */
+    void event_loop(GPUEventCallback callback);
+
     /**
      * @brief Read contents of a file
      * @param path Path to the file
@@ -169,12 +409,41 @@ private:
      */
     std::string get_process_name(uint32_t pid) const;
 
+    /**
+     * @brief Seed the sample timestamp of devices that were never polled
+     *
+     * Unpolled devices are primed together and share a single 100ms wait, so the
+     * first call costs one wait regardless of the number of GPUs.
+     * @param devices Devices about to be queried
+     */
+    void warm_up_process_utilization(const std::vector<const DeviceCache*>& devices) const;
+
+    /**
+     * @brief Get SM utilization per process from samples newer than the previous poll
+     * @param device Cached device to query
+     * @return Map of PID to SM utilization percent
+     */
+    std::unordered_map<unsigned int, float> read_process_utilization(const DeviceCache& device) const;
+
+    /**
+     * @brief Visit the running compute or graphics processes of a device
+     *
+     * Uses the newest available query (_v3, _v2, then the original one) and grows
+     * the shared buffer until every process fits.
+     * @param device Cached device to query
+     * @param graphics true for graphics processes, false for compute processes
+     * @param visitor Called with the PID and used memory in bytes of each process
+     * @return true if the query succeeded
+     */
+    bool for_each_running_process(const DeviceCache& device, bool graphics,
+                                  const std::function<void(unsigned int, unsigned long long)>& visitor) const;
+
     /**
      * @brief Get process information for a specific GPU
-     * @param device Handle to the GPU device
+     * @param device Cached device to query
      * @return Vector of process information
      */
-    std::vector<GPUProcessInfo> get_process_info_for_device(nvmlDevice_t device) const;
+    std::vector<GPUProcessInfo> get_process_info_for_device(const DeviceCache& device) const;
 
     /**
      * @brief Get information about all GPU processes
@@ -26,6 +26,25 @@ void print_overall_gpu_info(const hw_monitor::GPUDetector& detector) {
                  << "  Memory: " << gpu.used_memory_mb << "MB / "
                  << gpu.total_memory_mb << "MB\n"
                  << "  Utilization: " << gpu.utilization_percent << "%\n";
+        if (gpu.power_draw_watts >= 0) {
+            std::cout << "  Power: " << gpu.power_draw_watts << "W";
+            if (gpu.power_limit_watts >= 0) std::cout << " / " << gpu.power_limit_watts << "W";
+            std::cout << "\n";
+        }
+        if (gpu.sm_clock_mhz >= 0) {
+            std::cout << "  Clocks: SM " << gpu.sm_clock_mhz << "MHz, Memory " << gpu.memory_clock_mhz << "MHz\n";
+        } else if (gpu.graphics_clock_mhz >= 0) {
+            std::cout << "  Clocks: Graphics " << gpu.graphics_clock_mhz << "MHz, Memory " << gpu.memory_clock_mhz << "MHz\n";
+        }
+        if (gpu.rc6_residency_percent >= 0) {
+            std::cout << "  RC6 Residency: " << gpu.rc6_residency_percent << "%\n";
+        }
+        if (gpu.performance_state >= 0) {
+            std::cout << "  Performance State: P" << gpu.performance_state << "\n";
+        }
+        if (gpu.fan_speed_percent >= 0) {
+            std::cout << "  Fan: " << gpu.fan_speed_percent << "%\n";
+        }
     }
 }
 
@@ -147,6 +166,8 @@ void print_process_network_info(const hw_monitor::NetworkDetector& detector, con
                      << proc.receive_bytes_per_sec / (1024.0 * 1024.0) << " MB/s\n"
                      << "  Transmit Rate: " << proc.transmit_bytes_per_sec / (1024.0 * 1024.0) << " MB/s\n"
                      << "  Active Connections: " << proc.active_connections << "\n"
+                     << "  Recv-Q: " << proc.receive_queue_bytes << " bytes\n"
+                     << "  Send-Q: " << proc.send_queue_bytes << " bytes\n"
                      << "  Used Ports: ";
             for (auto port : proc.ports) {
                 std::cout << port << " ";
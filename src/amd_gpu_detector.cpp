@@ -1,11 +1,22 @@
 #include "amd_gpu_detector.hpp"
 #include <fstream>
-#include <regex>
+#include <map>
+#include <charconv>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <unordered_set>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace hw_monitor {
 
+namespace {
+
+constexpr std::string_view kfd_root = "/sys/class/kfd/kfd";
+
+} // namespace
+
 void AMDGPUDetector::debug_print(const std::string& msg) const {
     std::cerr << "AMD Debug: " << msg << std::endl;
 }
@@ -18,15 +29,38 @@ std::string AMDGPUDetector::read_file(const std::string& path) {
     return content;
 }
 
+std::optional<uint64_t> AMDGPUDetector::read_number(int fd) {
+    if (fd < 0) return std::nullopt;
+    char buffer[32];
+    ssize_t bytes = pread(fd, buffer, sizeof(buffer) - 1, 0);
+    if (bytes <= 0) return std::nullopt;
+    uint64_t value = 0;
+    auto [ptr, ec] = std::from_chars(buffer, buffer + bytes, value);
+    if (ec != std::errc()) return std::nullopt;
+    return value;
+}
+
 std::string AMDGPUDetector::find_hwmon_dir(const std::string& card_path) {
-    for (const auto& entry : std::filesystem::directory_iterator(card_path + "/device/hwmon")) {
-        if (std::filesystem::is_directory(entry.path())) {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(card_path + "/device/hwmon", ec)) {
+        if (entry.is_directory(ec)) {
             return entry.path().string();
         }
     }
     return "";
 }
 
+std::string AMDGPUDetector::find_render_node(const std::string& card_path) {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(card_path + "/device/drm", ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("renderD", 0) == 0) {
+            return "/dev/dri/" + name;
+        }
+    }
+    return "";
+}
+
 bool AMDGPUDetector::is_amd_gpu(const std::string& path) {
     constexpr std::string_view amd_vendor_id = "0x1002";
     std::string vendor = read_file(path + "/device/vendor");
@@ -39,21 +73,157 @@ AMDGPUDetector::AMDGPUDetector() : initialized_(false) {
     try {
         for (const auto& entry : std::filesystem::directory_iterator("/sys/class/drm")) {
             std::string path = entry.path().string();
-            if (path.find("card") != std::string::npos && std::filesystem::exists(path + "/device/vendor")) {
+
+            // Only cardN itself, not its connectors (cardN-DP-1, ...)
+            std::string card_name = entry.path().filename().string();
+            uint32_t index = 0;
+            if (card_name.rfind("card", 0) != 0) continue;
+            auto [ptr, ec] = std::from_chars(card_name.data() + 4, card_name.data() + card_name.size(), index);
+            if (ec != std::errc() || ptr != card_name.data() + card_name.size()) continue;
+
+            if (std::filesystem::exists(path + "/device/vendor")) {
                 debug_print("Found GPU device: " + path);
                 if (is_amd_gpu(path)) {
-                    gpu_paths_.push_back(path);
+                    CardHandles card;
+                    card.path = path;
+                    card.index = index;
+                    card.name = read_file(path + "/device/product_name");
+                    if (card.name.empty()) {
+                        card.name = "AMD GPU " + std::to_string(index);
+                    }
+                    std::error_code pdev_ec;
+                    card.pdev = std::filesystem::canonical(path + "/device", pdev_ec).filename().string();
+                    card.render_node = find_render_node(path);
+                    card.hwmon_dir = find_hwmon_dir(path);
+
+                    card.metrics_fd = open((path + "/device/gpu_metrics").c_str(), O_RDONLY | O_CLOEXEC);
+                    card.busy_fd = open((path + "/device/gpu_busy_percent").c_str(), O_RDONLY | O_CLOEXEC);
+                    card.vram_total_fd = open((path + "/device/mem_info_vram_total").c_str(), O_RDONLY | O_CLOEXEC);
+                    card.vram_used_fd = open((path + "/device/mem_info_vram_used").c_str(), O_RDONLY | O_CLOEXEC);
+                    for (int sensor = 1; card.temp_fd < 0 && sensor <= 8 && !card.hwmon_dir.empty(); ++sensor) {
+                        std::string temp_path = card.hwmon_dir + "/temp" + std::to_string(sensor) + "_input";
+                        card.temp_fd = open(temp_path.c_str(), O_RDONLY | O_CLOEXEC);
+                    }
+
+                    cards_.push_back(std::move(card));
                     initialized_ = true;
-                    debug_print("Added AMD GPU: " + path);
+                    debug_print("Added AMD GPU: " + path + " (" + cards_.back().render_node + ")");
                 }
             }
         }
-        debug_print("Found " + std::to_string(gpu_paths_.size()) + " AMD GPUs");
+        debug_print("Found " + std::to_string(cards_.size()) + " AMD GPUs");
+        resolve_kfd_topology();
     } catch (const std::exception& e) {
         debug_print("Error during initialization: " + std::string(e.what()));
     }
 }
 
+void AMDGPUDetector::resolve_kfd_topology() {
+    std::error_code ec;
+    for (const auto& node : std::filesystem::directory_iterator(std::string(kfd_root) + "/topology/nodes", ec)) {
+        // CPU nodes have gpu_id 0
+        uint32_t gpu_id = 0;
+        std::string gpu_id_str = read_file(node.path().string() + "/gpu_id");
+        std::from_chars(gpu_id_str.data(), gpu_id_str.data() + gpu_id_str.size(), gpu_id);
+        if (gpu_id == 0) continue;
+
+        std::map<std::string, uint64_t> properties;
+        std::ifstream properties_file(node.path().string() + "/properties");
+        std::string key;
+        uint64_t value;
+        while (properties_file >> key >> value) {
+            properties[key] = value;
+        }
+
+        std::string render_node = "/dev/dri/renderD" + std::to_string(properties["drm_render_minor"]);
+        for (auto& card : cards_) {
+            if (card.render_node != render_node) continue;
+            card.kfd_gpu_id = gpu_id;
+            if (properties["simd_per_cu"] > 0) {
+                card.compute_units = properties["simd_count"] / properties["simd_per_cu"];
+            }
+            debug_print("KFD gpu_id " + std::to_string(gpu_id) + " is card " + std::to_string(card.index));
+        }
+    }
+}
+
+std::vector<GPUProcessInfo> AMDGPUDetector::read_kfd_processes(const std::function<bool(uint32_t)>& process_matches) const {
+    std::vector<GPUProcessInfo> result;
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(kfd_mutex_);
+
+    std::unordered_set<uint32_t> kfd_pids;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(std::string(kfd_root) + "/proc", ec)) {
+        std::string pid_str = entry.path().filename().string();
+        uint32_t pid = 0;
+        auto [ptr, pid_ec] = std::from_chars(pid_str.data(), pid_str.data() + pid_str.size(), pid);
+        if (pid_ec != std::errc()) continue;
+        kfd_pids.insert(pid);
+        if (!process_matches(pid)) continue;
+
+        std::string proc_path = entry.path().string();
+        for (const auto& card : cards_) {
+            if (card.kfd_gpu_id == 0) continue;
+            std::string gpu_id = std::to_string(card.kfd_gpu_id);
+
+            // vram_<gpu_id> exists only for GPUs the process has opened
+            std::string vram = read_file(proc_path + "/vram_" + gpu_id);
+            if (vram.empty()) continue;
+
+            GPUProcessInfo proc_info{};
+            proc_info.pid = pid;
+            proc_info.process_name = read_file("/proc/" + pid_str + "/comm");
+            proc_info.gpu_index = card.index;
+            proc_info.memory_usage_mb = std::stoull(vram) / (1024.0f * 1024.0f);
+
+            // Compute units currently running the process's waves
+            std::string occupancy = read_file(proc_path + "/stats_" + gpu_id + "/cu_occupancy");
+            if (!occupancy.empty() && card.compute_units > 0) {
+                proc_info.engine_usage_percent["compute"] =
+                    std::min(100.0f, 100.0f * std::stoul(occupancy) / card.compute_units);
+            }
+
+            // SDMA busy time in microseconds, cumulative
+            std::string sdma = read_file(proc_path + "/sdma_" + gpu_id);
+            if (!sdma.empty()) {
+                uint64_t usec = std::stoull(sdma);
+                auto key = std::make_pair(pid, card.kfd_gpu_id);
+                auto previous = previous_sdma_.find(key);
+                if (previous != previous_sdma_.end() && usec >= previous->second.usec) {
+                    double elapsed_us = std::chrono::duration<double, std::micro>(now - previous->second.timestamp).count();
+                    if (elapsed_us > 0) {
+                        proc_info.engine_usage_percent["sdma"] =
+                            std::min(100.0f, static_cast<float>(100.0 * (usec - previous->second.usec) / elapsed_us));
+                    }
+                }
+                previous_sdma_[key] = {usec, now};
+            }
+
+            for (const auto& [engine, percent] : proc_info.engine_usage_percent) {
+                proc_info.gpu_usage_percent = std::max(proc_info.gpu_usage_percent, percent);
+            }
+            result.push_back(std::move(proc_info));
+        }
+    }
+
+    // Forget processes that have closed the KFD device or exited
+    if (!ec) {
+        std::erase_if(previous_sdma_, [&kfd_pids](const auto& entry) {
+            return kfd_pids.count(entry.first.first) == 0;
+        });
+    }
+    return result;
+}
+
+AMDGPUDetector::~AMDGPUDetector() {
+    for (const auto& card : cards_) {
+        for (int fd : {card.metrics_fd, card.busy_fd, card.vram_total_fd, card.vram_used_fd, card.temp_fd}) {
+            if (fd >= 0) close(fd);
+        }
+    }
+}
+
 bool AMDGPUDetector::is_available() const {
     return initialized_;
 }
@@ -62,46 +232,41 @@ std::vector<GPUInfo> AMDGPUDetector::get_gpu_info() const {
     std::vector<GPUInfo> result;
     if (!initialized_) return result;
 
-    for (const auto& path : gpu_paths_) {
+    for (const auto& card : cards_) {
         GPUInfo info;
-        
-        // Get GPU index
-        // FIXME: rewrite this without regex
-        std::smatch match;
-        std::regex card_regex("card(\\d+)");
-        std::string card_name = std::filesystem::path(path).filename();
-        if (std::regex_search(card_name, match, card_regex)) {
-            info.index = std::stoi(match[1]);
-        }
+        info.index = card.index;
+        info.name = card.name;
 
-        // Get GPU name
-        info.name = read_file(path + "/device/product_name");
-        if (info.name.empty()) {
-            info.name = "AMD GPU " + std::to_string(info.index);
+        // Temperature, activity, power and clocks in one read
+        auto metrics = card.metrics_fd >= 0 ? read_gpu_metrics(card.metrics_fd) : std::nullopt;
+        if (metrics) {
+            info.temperature_celsius = metrics->temperature_celsius.value_or(0);
+            info.power_draw_watts = metrics->socket_power_watts.value_or(-1);
+            info.graphics_clock_mhz = metrics->gfx_clock_mhz ? static_cast<int32_t>(*metrics->gfx_clock_mhz) : -1;
+            info.memory_clock_mhz = metrics->memory_clock_mhz ? static_cast<int32_t>(*metrics->memory_clock_mhz) : -1;
+            info.throttle_reasons = metrics->throttle_status ? static_cast<int64_t>(*metrics->throttle_status) : -1;
         }
 
-        // Get GPU utilization
-        std::string gpu_busy = read_file(path + "/device/gpu_busy_percent");
-        if (!gpu_busy.empty()) {
-            info.utilization_percent = std::stod(gpu_busy);
+        // Get GPU utilization, from gpu_busy_percent where gpu_metrics lacks it
+        if (metrics && metrics->gfx_activity_percent) {
+            info.utilization_percent = *metrics->gfx_activity_percent;
+        } else {
+            info.utilization_percent = read_number(card.busy_fd).value_or(0);
         }
 
         // Get memory info
         constexpr uint64_t mb_to_bytes = 1024 * 1024;
-        std::string vram_total = read_file(path + "/device/mem_info_vram_total");
-        std::string vram_used = read_file(path + "/device/mem_info_vram_used");
-        if (!vram_total.empty() && !vram_used.empty()) {
-            info.total_memory_mb = std::stoull(vram_total) / mb_to_bytes;
-            info.used_memory_mb = std::stoull(vram_used) / mb_to_bytes;
+        auto vram_total = read_number(card.vram_total_fd);
+        auto vram_used = read_number(card.vram_used_fd);
+        if (vram_total && vram_used) {
+            info.total_memory_mb = *vram_total / mb_to_bytes;
+            info.used_memory_mb = *vram_used / mb_to_bytes;
         }
 
         // Get temperature
-        std::string hwmon_dir = find_hwmon_dir(path);
-        if (!hwmon_dir.empty()) {
-            std::string temp = read_file(hwmon_dir + "/temp1_input");
-            if (!temp.empty()) {
-                info.temperature_celsius = std::stoi(temp) / 1000.0;
-            }
+        if (!metrics || !metrics->temperature_celsius) {
+            auto temp = read_number(card.temp_fd);
+            info.temperature_celsius = temp ? *temp / 1000.0 : 0;
         }
 
         result.push_back(std::move(info));
@@ -118,128 +283,122 @@ std::optional<std::vector<GPUProcessInfo>> AMDGPUDetector::get_process_info(cons
 
     debug_print("Searching for process: " + process_name);
 
-    // Scan /proc for the process
-    for (const auto& entry : std::filesystem::directory_iterator("/proc")) {
-        if (!std::filesystem::is_directory(entry.path())) continue;
-        
+    // Resolve the name once per process, checking it in multiple locations
+    auto process_matches = [&process_name](const std::string& proc_path) {
+        std::string comm = read_file(proc_path + "/comm");
+        if (!comm.empty() && comm.find(process_name) != std::string::npos) return true;
+        std::string cmdline = read_file(proc_path + "/cmdline");
+        return !cmdline.empty() && cmdline.find(process_name) != std::string::npos;
+    };
+    std::unordered_set<uint32_t> matching;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/proc", ec)) {
         std::string pid_str = entry.path().filename().string();
-        if (pid_str.find_first_not_of("0123456789") != std::string::npos) continue;
-        
-        // Check process name in multiple locations
-        bool process_match = false;
-        uint32_t pid = std::stoul(pid_str);
-
-        std::string comm = read_file(entry.path().string() + "/comm");
-        if (!comm.empty() && comm.find(process_name) != std::string::npos) {
-            process_match = true;
-            debug_print("Found matching process: " + comm + " (PID: " + pid_str + ")");
-        }
+        if (pid_str.empty() || pid_str.find_first_not_of("0123456789") != std::string::npos) continue;
+        if (process_matches(entry.path().string())) matching.insert(std::stoul(pid_str));
+    }
+
+    // ROCm compute processes from KFD accounting
+    constexpr uint64_t mb_to_bytes = 1024 * 1024;
+    std::unordered_set<uint32_t> reported;
+    for (auto& proc_info : read_kfd_processes([&matching](uint32_t pid) { return matching.count(pid) > 0; })) {
+        debug_print("Process " + proc_info.process_name + " (PID: " + std::to_string(proc_info.pid) +
+                    ") KFD GPU " + std::to_string(proc_info.gpu_index) + ": " +
+                    std::to_string(proc_info.memory_usage_mb) + " MB");
+        reported.insert(proc_info.pid);
+        result.push_back(std::move(proc_info));
+    }
+
+    // Per-process engine usage and memory from DRM fdinfo, for processes KFD did not cover
+    std::vector<uint32_t> remaining;
+    for (uint32_t pid : matching) {
+        if (!reported.count(pid)) remaining.push_back(pid);
+    }
+    for (const auto& usage : fdinfo_reader_.sample(remaining)) {
+        auto card = std::find_if(cards_.begin(), cards_.end(),
+                                 [&usage](const CardHandles& c) { return c.pdev == usage.pdev; });
+        if (usage.driver != "amdgpu" || card == cards_.end()) continue;
 
-        if (!process_match) {
-            std::string cmdline = read_file(entry.path().string() + "/cmdline");
-            if (!cmdline.empty() && cmdline.find(process_name) != std::string::npos) {
-                process_match = true;
-                debug_print("Found matching process in cmdline: " + cmdline + " (PID: " + pid_str + ")");
+        GPUProcessInfo proc_info{};
+        proc_info.pid = usage.pid;
+        proc_info.process_name = usage.process_name;
+        proc_info.gpu_index = card->index;
+
+        auto vram = usage.memory_bytes.find("vram");
+        if (vram != usage.memory_bytes.end()) {
+            proc_info.memory_usage_mb = static_cast<float>(vram->second) / mb_to_bytes;
+        } else {
+            for (const auto& [region, bytes] : usage.memory_bytes) {
+                proc_info.memory_usage_mb += static_cast<float>(bytes) / mb_to_bytes;
             }
         }
 
-        if (process_match) {
-            bool uses_gpu = false;
-            std::string gpu_path;
-
-            // Check maps for GPU usage
-            std::string maps_path = entry.path().string() + "/maps";
-            std::ifstream maps_file(maps_path);
-            std::string line;
-            while (std::getline(maps_file, line)) {
-                if (line.find("/dev/dri/") != std::string::npos || line.find("amdgpu") != std::string::npos || line.find("radeon") != std::string::npos) {
-                    uses_gpu = true;
-                    gpu_path = line;
-                    debug_print("Process uses GPU: " + line);
-                    break;
-                }
-            }
+        // Overall usage is the busiest engine
+        proc_info.engine_usage_percent = usage.engine_busy_percent;
+        for (const auto& [engine, percent] : usage.engine_busy_percent) {
+            proc_info.gpu_usage_percent = std::max(proc_info.gpu_usage_percent, percent);
+        }
 
-            // Check file descriptors
-            if (!uses_gpu) {
-                std::string fd_path = entry.path().string() + "/fd";
-                if (std::filesystem::exists(fd_path)) {
-                    for (const auto& fd : std::filesystem::directory_iterator(fd_path)) {
-                        if (std::filesystem::is_symlink(fd.path())) {
-                            std::error_code ec;
-                            std::string target = std::filesystem::read_symlink(fd.path(), ec).string();
-                            if (!ec && (target.find("/dev/dri/") != std::string::npos || target.find("amdgpu") != std::string::npos)) {
-                                uses_gpu = true;
-                                gpu_path = target;
-                                debug_print("Process uses GPU (fd): " + target);
-                                break;
-                            }
-                        }
-                    }
-                }
+        debug_print("Process " + proc_info.process_name + " (PID: " + std::to_string(proc_info.pid) +
+                    ") GPU " + std::to_string(proc_info.gpu_index) + ": " +
+                    std::to_string(proc_info.gpu_usage_percent) + "%, " +
+                    std::to_string(proc_info.memory_usage_mb) + " MB");
+        reported.insert(proc_info.pid);
+        result.push_back(std::move(proc_info));
+    }
+
+    // Kernels without DRM fdinfo stats: fall back to render node mappings. Only processes
+    // holding one of the cards open without an fdinfo client are read, so processes that
+    // do not use the GPU are skipped on kernels that do report stats
+    auto holds_card = [this](const std::string& proc_path) {
+        std::error_code fd_ec;
+        for (const auto& fd : std::filesystem::directory_iterator(proc_path + "/fd", fd_ec)) {
+            std::error_code link_ec;
+            std::string target = std::filesystem::read_symlink(fd.path(), link_ec).string();
+            if (link_ec) continue;
+            for (const auto& card : cards_) {
+                if (target == card.render_node || target == "/dev/dri/card" + std::to_string(card.index)) return true;
             }
+        }
+        return false;
+    };
+    for (uint32_t pid : remaining) {
+        std::string proc_path = "/proc/" + std::to_string(pid);
+        if (reported.count(pid) || !holds_card(proc_path)) continue;
 
-            if (uses_gpu) {
-                GPUProcessInfo proc_info;
-                proc_info.pid = pid;
-                proc_info.process_name = comm;
-                
-                // Calculate total GPU memory used by this process from maps
-                uint64_t total_gpu_mem = 0;
-                std::string maps_path = entry.path().string() + "/maps";
-                std::ifstream maps_file(maps_path);
-                while (std::getline(maps_file, line)) {
-                    if (line.find("/dev/dri/renderD128") != std::string::npos) {
-                        // Parse memory region size
-                        size_t dash_pos = line.find('-');
-                        if (dash_pos != std::string::npos) {
-                            std::string start_addr = line.substr(0, dash_pos);
-                            std::string end_addr = line.substr(dash_pos + 1, line.find(' ') - dash_pos - 1);
-                            try {
-                                total_gpu_mem += (std::stoull(end_addr, nullptr, 16) - std::stoull(start_addr, nullptr, 16));
-                            // Just skip the cycle
-                            } catch (...) {}
-                        }
-                    }
-                }
-                constexpr uint64_t mb_to_bytes = 1024 * 1024;
-                proc_info.memory_usage_mb = total_gpu_mem / mb_to_bytes;
-                debug_print("Process GPU memory: " + std::to_string(proc_info.memory_usage_mb) + " MB");
-
-                // Try to get GPU index and usage
-                for (const auto& path : gpu_paths_) {
-                    if (gpu_path.find(std::filesystem::path(path).filename().string()) != std::string::npos) {
-                        std::smatch match;
-                        std::regex card_regex("card(\\d+)");
-                        std::string card_name = std::filesystem::path(path).filename();
-                        if (std::regex_search(card_name, match, card_regex)) {
-                            proc_info.gpu_index = std::stoi(match[1]);
-                            debug_print("Process using GPU " + std::to_string(proc_info.gpu_index));
-
-                            // Get total VRAM usage percentage
-                            std::string vram_used = read_file(path + "/device/mem_info_vram_used");
-                            std::string vram_total = read_file(path + "/device/mem_info_vram_total");
-                            if (!vram_used.empty() && !vram_total.empty()) {
-                                try {
-                                    float used_mb = std::stoull(vram_used) / mb_to_bytes;
-                                    float total_mb = std::stoull(vram_total) / mb_to_bytes;
-                                    float usage_percent = (used_mb / total_mb) * 100.0f;
-                                    proc_info.gpu_usage_percent = usage_percent;
-                                    debug_print("VRAM usage: " + std::to_string(used_mb) + "MB / " + 
-                                              std::to_string(total_mb) + "MB (" + 
-                                              std::to_string(usage_percent) + "%)");
-                                } catch (...) {
-                                    proc_info.gpu_usage_percent = 0;
-                                }
-                            }
-                        }
-                        break;
-                    }
-                }
+        // Calculate GPU memory mapped from each card's render node
+        std::map<uint32_t, uint64_t> mapped_by_card;
+        std::ifstream maps_file(proc_path + "/maps");
+        std::string line;
+        while (std::getline(maps_file, line)) {
+            auto card = std::find_if(cards_.begin(), cards_.end(), [&line](const CardHandles& c) {
+                return !c.render_node.empty() && line.find(c.render_node) != std::string::npos;
+            });
+            if (card == cards_.end()) continue;
+            uint64_t& total_gpu_mem = mapped_by_card[card->index];
 
-                result.push_back(std::move(proc_info));
+            // Parse memory region size
+            size_t dash_pos = line.find('-');
+            if (dash_pos != std::string::npos) {
+                std::string start_addr = line.substr(0, dash_pos);
+                std::string end_addr = line.substr(dash_pos + 1, line.find(' ') - dash_pos - 1);
+                try {
+                    total_gpu_mem += (std::stoull(end_addr, nullptr, 16) - std::stoull(start_addr, nullptr, 16));
+                // Just skip the cycle
+                } catch (...) {}
             }
         }
+
+        for (const auto& [gpu_index, total_gpu_mem] : mapped_by_card) {
+            GPUProcessInfo proc_info{};
+            proc_info.pid = pid;
+            proc_info.process_name = read_file(proc_path + "/comm");
+            proc_info.gpu_index = gpu_index;
+            proc_info.memory_usage_mb = total_gpu_mem / mb_to_bytes;
+            proc_info.gpu_usage_percent = -1;  // Not available without fdinfo
+            debug_print("Process GPU memory (maps): " + std::to_string(proc_info.memory_usage_mb) + " MB");
+            result.push_back(std::move(proc_info));
+        }
     }
 
     debug_print("Found " + std::to_string(result.size()) + " matching processes");
@@ -248,10 +407,16 @@ std::optional<std::vector<GPUProcessInfo>> AMDGPUDetector::get_process_info(cons
 
 std::optional<std::vector<GPUProcessInfo>> AMDGPUDetector::get_process_info(uint32_t pid) const {
     std::string comm_path = "/proc/" + std::to_string(pid) + "/comm";
-    if (std::filesystem::exists(comm_path)) {
-        return get_process_info(read_file(comm_path));
+    if (!std::filesystem::exists(comm_path)) return std::nullopt;
+
+    // Processes sharing the name are matched too; keep only the requested one
+    auto by_name = get_process_info(read_file(comm_path));
+    if (!by_name) return std::nullopt;
+    std::vector<GPUProcessInfo> result;
+    for (auto& proc : *by_name) {
+        if (proc.pid == pid) result.push_back(std::move(proc));
     }
-    return std::nullopt;
+    return result.empty() ? std::nullopt : std::make_optional(result);
 }
 
 std::optional<GPUInfo> AMDGPUDetector::get_gpu_info(uint32_t gpu_index) const {
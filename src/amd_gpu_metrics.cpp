@@ -0,0 +1,158 @@
+#include "amd_gpu_metrics.hpp"
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <unistd.h>
+
+namespace hw_monitor {
+
+namespace {
+
+/**
+ * Little-endian field read, bounded by the blob size. Fields the firmware does not
+ * populate are set to all ones and reported as missing.
+ */
+template <typename T>
+std::optional<T> field(const uint8_t* data, size_t size, size_t offset) {
+    if (offset + sizeof(T) > size) return std::nullopt;
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    if (value == static_cast<T>(~T{0})) return std::nullopt;
+    return value;
+}
+
+template <typename T>
+std::optional<float> scaled(std::optional<T> value, float divisor) {
+    if (!value) return std::nullopt;
+    return static_cast<float>(*value) / divisor;
+}
+
+template <typename T>
+std::optional<uint32_t> widened(std::optional<T> value) {
+    if (!value) return std::nullopt;
+    return static_cast<uint32_t>(*value);
+}
+
+// Byte offsets below follow the natural alignment of struct gpu_metrics_vX_Y
+
+/**
+ * v1.1-v1.3 (dGPU): temperatures in C, activity in %, socket power in W
+ */
+void parse_v1(const uint8_t* data, size_t size, AMDGPUMetrics& metrics) {
+    metrics.temperature_celsius = scaled(field<uint16_t>(data, size, 4), 1.0f);
+    metrics.hotspot_celsius = scaled(field<uint16_t>(data, size, 6), 1.0f);
+    metrics.memory_temperature_celsius = scaled(field<uint16_t>(data, size, 8), 1.0f);
+    metrics.gfx_activity_percent = scaled(field<uint16_t>(data, size, 16), 1.0f);
+    metrics.memory_activity_percent = scaled(field<uint16_t>(data, size, 18), 1.0f);
+    metrics.media_activity_percent = scaled(field<uint16_t>(data, size, 20), 1.0f);
+    metrics.socket_power_watts = scaled(field<uint16_t>(data, size, 22), 1.0f);
+    metrics.gfx_clock_mhz = widened(field<uint16_t>(data, size, 54));
+    metrics.soc_clock_mhz = widened(field<uint16_t>(data, size, 56));
+    metrics.memory_clock_mhz = widened(field<uint16_t>(data, size, 58));
+    metrics.throttle_status = field<uint32_t>(data, size, 68);
+    metrics.fan_speed_rpm = widened(field<uint16_t>(data, size, 72));
+}
+
+/**
+ * v1.4 and later (MI300 class): leading temperatures, power and activity only
+ */
+void parse_v1_4(const uint8_t* data, size_t size, AMDGPUMetrics& metrics) {
+    metrics.hotspot_celsius = scaled(field<uint16_t>(data, size, 4), 1.0f);
+    metrics.memory_temperature_celsius = scaled(field<uint16_t>(data, size, 6), 1.0f);
+    metrics.temperature_celsius = metrics.hotspot_celsius;
+    metrics.socket_power_watts = scaled(field<uint16_t>(data, size, 10), 1.0f);
+    metrics.gfx_activity_percent = scaled(field<uint16_t>(data, size, 12), 1.0f);
+    metrics.memory_activity_percent = scaled(field<uint16_t>(data, size, 14), 1.0f);
+    metrics.media_activity_percent = scaled(field<uint16_t>(data, size, 16), 1.0f);
+}
+
+/**
+ * v2.0 (APU): temperatures in centi-C, activity in %, socket power in mW. Places
+ * system_clock_counter ahead of the temperatures.
+ */
+void parse_v2_0(const uint8_t* data, size_t size, AMDGPUMetrics& metrics) {
+    metrics.temperature_celsius = scaled(field<uint16_t>(data, size, 16), 100.0f);
+    metrics.gfx_activity_percent = scaled(field<uint16_t>(data, size, 40), 1.0f);
+    metrics.media_activity_percent = scaled(field<uint16_t>(data, size, 42), 1.0f);
+    metrics.socket_power_watts = scaled(field<uint16_t>(data, size, 44), 1000.0f);
+    metrics.gfx_clock_mhz = widened(field<uint16_t>(data, size, 80));
+    metrics.soc_clock_mhz = widened(field<uint16_t>(data, size, 82));
+    metrics.memory_clock_mhz = widened(field<uint16_t>(data, size, 84));
+    metrics.throttle_status = field<uint32_t>(data, size, 112);
+}
+
+/**
+ * v2.1 and later (APU): as v2.0, with system_clock_counter moved after the activity fields
+ */
+void parse_v2_1(const uint8_t* data, size_t size, AMDGPUMetrics& metrics) {
+    metrics.temperature_celsius = scaled(field<uint16_t>(data, size, 4), 100.0f);
+    metrics.gfx_activity_percent = scaled(field<uint16_t>(data, size, 28), 1.0f);
+    metrics.media_activity_percent = scaled(field<uint16_t>(data, size, 30), 1.0f);
+    metrics.socket_power_watts = scaled(field<uint16_t>(data, size, 40), 1000.0f);
+    metrics.gfx_clock_mhz = widened(field<uint16_t>(data, size, 76));
+    metrics.soc_clock_mhz = widened(field<uint16_t>(data, size, 78));
+    metrics.memory_clock_mhz = widened(field<uint16_t>(data, size, 80));
+    metrics.throttle_status = field<uint32_t>(data, size, 108);
+}
+
+/**
+ * v3.x (APU): temperatures in centi-C, activity in %, socket power in mW, average clocks only
+ */
+void parse_v3(const uint8_t* data, size_t size, AMDGPUMetrics& metrics) {
+    metrics.temperature_celsius = scaled(field<uint16_t>(data, size, 4), 100.0f);
+    metrics.gfx_activity_percent = scaled(field<uint16_t>(data, size, 42), 1.0f);
+    metrics.media_activity_percent = scaled(field<uint16_t>(data, size, 44), 1.0f);
+    metrics.socket_power_watts = scaled(field<uint32_t>(data, size, 112), 1000.0f);
+    metrics.gfx_clock_mhz = widened(field<uint16_t>(data, size, 174));
+    metrics.soc_clock_mhz = widened(field<uint16_t>(data, size, 176));
+    metrics.memory_clock_mhz = widened(field<uint16_t>(data, size, 186));
+}
+
+} // namespace
+
+std::optional<AMDGPUMetrics> parse_gpu_metrics(const uint8_t* data, size_t size) {
+    // struct metrics_table_header: structure_size, format_revision, content_revision
+    auto structure_size = field<uint16_t>(data, size, 0);
+    if (!structure_size || size < 4) return std::nullopt;
+    size = std::min<size_t>(size, *structure_size);
+
+    AMDGPUMetrics metrics{};
+    metrics.format_revision = data[2];
+    metrics.content_revision = data[3];
+
+    switch (metrics.format_revision) {
+        case 1:
+            // v1.0 places system_clock_counter ahead of the temperatures, shifting every field;
+            // leave it to the sysfs fallback
+            if (metrics.content_revision == 0) return std::nullopt;
+            if (metrics.content_revision >= 4) {
+                parse_v1_4(data, size, metrics);
+            } else {
+                parse_v1(data, size, metrics);
+            }
+            break;
+        case 2:
+            if (metrics.content_revision == 0) {
+                parse_v2_0(data, size, metrics);
+            } else {
+                parse_v2_1(data, size, metrics);
+            }
+            break;
+        case 3:
+            parse_v3(data, size, metrics);
+            break;
+        default:
+            return std::nullopt;
+    }
+    return metrics;
+}
+
+std::optional<AMDGPUMetrics> read_gpu_metrics(int fd) {
+    // Largest known layouts are a little over 1KB
+    std::array<uint8_t, 4096> buffer;
+    ssize_t bytes = pread(fd, buffer.data(), buffer.size(), 0);
+    if (bytes <= 0) return std::nullopt;
+    return parse_gpu_metrics(buffer.data(), static_cast<size_t>(bytes));
+}
+
+} // namespace hw_monitor
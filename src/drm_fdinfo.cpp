@@ -0,0 +1,251 @@
+#include "drm_fdinfo.hpp"
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <thread>
+
+namespace hw_monitor {
+
+namespace {
+
+/**
+ * Parse "<value> [unit]" memory values, where unit is B, KiB, MiB or GiB
+ */
+uint64_t parse_memory_value(const std::string& value) {
+    std::istringstream iss(value);
+    uint64_t amount = 0;
+    std::string unit;
+    iss >> amount >> unit;
+    if (unit == "KiB") return amount << 10;
+    if (unit == "MiB") return amount << 20;
+    if (unit == "GiB") return amount << 30;
+    return amount;
+}
+
+uint64_t parse_number(const std::string& value) {
+    return std::strtoull(value.c_str(), nullptr, 10);
+}
+
+bool starts_with(const std::string& s, const std::string& prefix) {
+    return s.compare(0, prefix.size(), prefix) == 0;
+}
+
+std::string read_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+} // namespace
+
+DRMFdinfoReader::DRMFdinfoReader(std::string proc_root) : proc_root_(std::move(proc_root)) {}
+
+std::optional<DRMClientSample> DRMFdinfoReader::parse_fdinfo(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) return std::nullopt;
+
+    DRMClientSample client{};
+    bool has_client_id = false;
+
+    // Regions reported with the newer drm-resident-* keys take precedence over drm-memory-*
+    std::map<std::string, uint64_t> legacy_memory;
+    std::map<std::string, uint64_t> total_memory;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!starts_with(line, "drm-")) continue;
+
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        std::string key = line.substr(0, colon);
+        size_t value_start = line.find_first_not_of(" \t", colon + 1);
+        std::string value = value_start == std::string::npos ? "" : line.substr(value_start);
+
+        if (key == "drm-driver") {
+            client.driver = value;
+        } else if (key == "drm-pdev") {
+            client.pdev = value;
+        } else if (key == "drm-client-id") {
+            client.client_id = parse_number(value);
+            has_client_id = true;
+        } else if (starts_with(key, "drm-engine-capacity-")) {
+            client.engine_capacity[key.substr(20)] = parse_number(value);
+        } else if (starts_with(key, "drm-engine-")) {
+            client.engine_ns[key.substr(11)] = parse_number(value);
+        } else if (starts_with(key, "drm-total-cycles-")) {
+            client.total_cycles[key.substr(17)] = parse_number(value);
+        } else if (starts_with(key, "drm-cycles-")) {
+            client.cycles[key.substr(11)] = parse_number(value);
+        } else if (starts_with(key, "drm-resident-")) {
+            client.memory_bytes[key.substr(13)] = parse_memory_value(value);
+        } else if (starts_with(key, "drm-memory-")) {
+            legacy_memory[key.substr(11)] = parse_memory_value(value);
+        } else if (starts_with(key, "drm-total-")) {
+            total_memory[key.substr(10)] = parse_memory_value(value);
+        }
+    }
+
+    if (!has_client_id) return std::nullopt;
+
+    for (const auto* fallback : {&legacy_memory, &total_memory}) {
+        for (const auto& [region, bytes] : *fallback) {
+            client.memory_bytes.try_emplace(region, bytes);
+        }
+    }
+
+    client.timestamp = std::chrono::steady_clock::now();
+    return client;
+}
+
+std::string DRMFdinfoReader::client_key(const DRMClientSample& client) {
+    return client.driver + "|" + client.pdev + "|" + std::to_string(client.client_id);
+}
+
+std::vector<DRMClientSample> DRMFdinfoReader::read_clients(const std::function<bool(uint32_t)>& pid_filter) const {
+    std::vector<uint32_t> pids;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(proc_root_, ec)) {
+        std::string pid_str = entry.path().filename().string();
+        if (pid_str.empty() || pid_str.find_first_not_of("0123456789") != std::string::npos) continue;
+
+        uint32_t pid = std::stoul(pid_str);
+        if (pid_filter && !pid_filter(pid)) continue;
+        pids.push_back(pid);
+    }
+    return read_clients(pids);
+}
+
+std::vector<DRMClientSample> DRMFdinfoReader::read_clients(const std::vector<uint32_t>& pids) const {
+    std::vector<DRMClientSample> result;
+    std::map<std::string, size_t> seen;
+
+    for (uint32_t pid : pids) {
+        std::filesystem::path process_dir = std::filesystem::path(proc_root_) / std::to_string(pid);
+
+        std::error_code fd_ec;
+        for (const auto& fd : std::filesystem::directory_iterator(process_dir / "fd", fd_ec)) {
+            std::error_code link_ec;
+            std::string target = std::filesystem::read_symlink(fd.path(), link_ec).string();
+            if (link_ec || target.find("/dev/dri/") == std::string::npos) continue;
+
+            auto client = parse_fdinfo((process_dir / "fdinfo" / fd.path().filename()).string());
+            if (!client) continue;
+            client->pid = pid;
+
+            // Duplicated or inherited descriptors share the client; keep the lowest PID
+            auto [it, inserted] = seen.try_emplace(client_key(*client), result.size());
+            if (inserted) {
+                result.push_back(std::move(*client));
+            } else if (pid < result[it->second].pid) {
+                result[it->second].pid = pid;
+            }
+        }
+    }
+
+    return result;
+}
+
+std::vector<DRMProcessUsage> DRMFdinfoReader::sample(const std::function<bool(uint32_t)>& pid_filter) {
+    return sample_clients([&] { return read_clients(pid_filter); }, pid_filter != nullptr);
+}
+
+std::vector<DRMProcessUsage> DRMFdinfoReader::sample(const std::vector<uint32_t>& pids) {
+    return sample_clients([&] { return read_clients(pids); }, true);
+}
+
+std::vector<DRMProcessUsage> DRMFdinfoReader::sample_clients(const std::function<std::vector<DRMClientSample>()>& read,
+                                                             bool filtered) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto clients = read();
+
+    // Clients without a previous reading get a 100ms baseline, shared by all of them
+    bool needs_baseline = std::any_of(clients.begin(), clients.end(), [this](const DRMClientSample& client) {
+        return previous_.find(client_key(client)) == previous_.end();
+    });
+    if (needs_baseline) {
+        for (const auto& client : clients) {
+            previous_[client_key(client)] = {client.engine_ns, client.cycles, client.total_cycles, client.timestamp};
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        clients = read();
+    }
+
+    std::map<std::pair<uint32_t, std::string>, DRMProcessUsage> usage;
+    std::map<std::string, PreviousCounters> current;
+
+    for (const auto& client : clients) {
+        std::string key = client_key(client);
+        auto& process = usage[{client.pid, client.driver + "|" + client.pdev}];
+        process.pid = client.pid;
+        process.driver = client.driver;
+        process.pdev = client.pdev;
+        process.client_count++;
+        for (const auto& [region, bytes] : client.memory_bytes) {
+            process.memory_bytes[region] += bytes;
+        }
+
+        auto previous = previous_.find(key);
+        if (previous != previous_.end()) {
+            const PreviousCounters& before = previous->second;
+
+            // Cycle counters are exact where present (xe); otherwise use busy time over wall time
+            for (const auto& [engine, cycles] : client.cycles) {
+                auto total = client.total_cycles.find(engine);
+                auto cycles_before = before.cycles.find(engine);
+                auto total_before = before.total_cycles.find(engine);
+                if (total == client.total_cycles.end() || cycles_before == before.cycles.end() ||
+                    total_before == before.total_cycles.end() || total->second <= total_before->second ||
+                    cycles < cycles_before->second) {
+                    continue;
+                }
+                // Total cycles count one instance, busy cycles every instance of the class
+                auto capacity = client.engine_capacity.find(engine);
+                uint64_t instances = capacity != client.engine_capacity.end() && capacity->second > 0 ? capacity->second : 1;
+                float percent = 100.0f * (cycles - cycles_before->second) /
+                                ((total->second - total_before->second) * instances);
+                process.engine_busy_percent[engine] += percent;
+            }
+
+            double elapsed_ns = std::chrono::duration<double, std::nano>(client.timestamp - before.timestamp).count();
+            for (const auto& [engine, busy_ns] : client.engine_ns) {
+                auto busy_before = before.engine_ns.find(engine);
+                if (busy_before == before.engine_ns.end() || elapsed_ns <= 0 || busy_ns < busy_before->second) continue;
+                if (client.cycles.count(engine) && client.total_cycles.count(engine)) continue;
+
+                auto capacity = client.engine_capacity.find(engine);
+                uint64_t instances = capacity != client.engine_capacity.end() && capacity->second > 0 ? capacity->second : 1;
+                float percent = 100.0f * (busy_ns - busy_before->second) / (elapsed_ns * instances);
+                process.engine_busy_percent[engine] += percent;
+            }
+        }
+
+        current[key] = {client.engine_ns, client.cycles, client.total_cycles, client.timestamp};
+    }
+
+    // A full scan also forgets clients that closed their descriptors; a filtered one only
+    // forgets clients not seen for a while, as it cannot tell them from filtered-out ones
+    if (filtered) {
+        for (auto& [key, counters] : current) previous_[key] = std::move(counters);
+        auto now = std::chrono::steady_clock::now();
+        std::erase_if(previous_, [now](const auto& entry) {
+            return now - entry.second.timestamp > stale_after;
+        });
+    } else {
+        previous_ = std::move(current);
+    }
+
+    std::vector<DRMProcessUsage> result;
+    for (auto& [key, process] : usage) {
+        for (auto& [engine, percent] : process.engine_busy_percent) {
+            percent = std::clamp(percent, 0.0f, 100.0f);
+        }
+        process.process_name = read_line(proc_root_ + "/" + std::to_string(process.pid) + "/comm");
+        result.push_back(std::move(process));
+    }
+    return result;
+}
+
+} // namespace hw_monitor
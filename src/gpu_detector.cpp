@@ -1,6 +1,7 @@
 #include "gpu_detector.hpp"
 #include "nvidia_gpu_detector.hpp"
 #include "amd_gpu_detector.hpp"
+#include "intel_gpu_detector.hpp"
 
 namespace hw_monitor {
 
@@ -21,6 +22,12 @@ GPUDetector::GPUDetector() {
     if (amd_impl->is_available()) {
         implementations_.push_back(std::move(amd_impl));
     }
+
+    // Try to create Intel implementation
+    auto intel_impl = std::make_unique<IntelGPUDetector>();
+    if (intel_impl->is_available()) {
+        implementations_.push_back(std::move(intel_impl));
+    }
 }
 
 std::vector<GPUInfo> GPUDetector::get_gpu_info() const {
@@ -61,4 +68,36 @@ std::optional<GPUInfo> GPUDetector::get_gpu_info(uint32_t gpu_index) const {
     return std::nullopt;
 }
 
+std::vector<GPUSampleStats> GPUDetector::get_sample_stats() const {
+    std::vector<GPUSampleStats> result;
+    for (const auto& impl : implementations_) {
+        auto stats = impl->get_sample_stats();
+        result.insert(result.end(), stats.begin(), stats.end());
+    }
+    return result;
+}
+
+std::vector<GPUAccountingInfo> GPUDetector::get_accounting_info() const {
+    std::vector<GPUAccountingInfo> result;
+    for (const auto& impl : implementations_) {
+        auto records = impl->get_accounting_info();
+        result.insert(result.end(), records.begin(), records.end());
+    }
+    return result;
+}
+
+bool GPUDetector::start_event_listener(GPUEventCallback callback) {
+    bool started = false;
+    for (const auto& impl : implementations_) {
+        started |= impl->start_event_listener(callback);
+    }
+    return started;
+}
+
+void GPUDetector::stop_event_listener() {
+    for (const auto& impl : implementations_) {
+        impl->stop_event_listener();
+    }
+}
+
 } // namespace hw_monitor 
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include "intel_gpu_detector.hpp"
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <charconv>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace hw_monitor {
+
+void IntelGPUDetector::debug_print(const std::string& msg) const {
+    std::cerr << "Intel Debug: " << msg << std::endl;
+}
+
+std::string IntelGPUDetector::read_file(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) return "";
+    std::string content;
+    std::getline(file, content);
+    return content;
+}
+
+std::optional<uint64_t> IntelGPUDetector::read_number(int fd) {
+    if (fd < 0) return std::nullopt;
+    char buffer[32];
+    ssize_t bytes = pread(fd, buffer, sizeof(buffer) - 1, 0);
+    if (bytes <= 0) return std::nullopt;
+    uint64_t value = 0;
+    auto [ptr, ec] = std::from_chars(buffer, buffer + bytes, value);
+    if (ec != std::errc()) return std::nullopt;
+    return value;
+}
+
+int IntelGPUDetector::open_first(const std::vector<std::string>& candidates) {
+    for (const auto& path : candidates) {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) return fd;
+    }
+    return -1;
+}
+
+IntelGPUDetector::CounterSample IntelGPUDetector::read_counters(const CardHandles& card) {
+    return {read_number(card.rc6_fd), read_number(card.energy_fd), std::chrono::steady_clock::now()};
+}
+
+IntelGPUDetector::IntelGPUDetector(const std::string& sysfs_root, std::string proc_root)
+    : initialized_(false), proc_root_(proc_root), fdinfo_reader_(std::move(proc_root)) {
+    debug_print("Initializing Intel GPU detector");
+    try {
+        for (const auto& entry : std::filesystem::directory_iterator(sysfs_root + "/class/drm")) {
+            std::string path = entry.path().string();
+
+            // Only cardN itself, not its connectors (cardN-DP-1, ...)
+            std::string card_name = entry.path().filename().string();
+            uint32_t index = 0;
+            if (card_name.rfind("card", 0) != 0) continue;
+            auto [ptr, ec] = std::from_chars(card_name.data() + 4, card_name.data() + card_name.size(), index);
+            if (ec != std::errc() || ptr != card_name.data() + card_name.size()) continue;
+
+            std::string vendor = read_file(path + "/device/vendor");
+            if (vendor.find("0x8086") == std::string::npos) continue;
+
+            std::error_code driver_ec;
+            std::string driver = std::filesystem::read_symlink(path + "/device/driver", driver_ec).filename().string();
+            if (driver != "i915" && driver != "xe") {
+                debug_print("Skipping " + path + " with driver " + driver);
+                continue;
+            }
+
+            CardHandles card;
+            card.path = path;
+            card.index = index;
+            card.driver = driver;
+            card.name = "Intel GPU " + read_file(path + "/device/device");
+            std::error_code pdev_ec;
+            card.pdev = std::filesystem::canonical(path + "/device", pdev_ec).filename().string();
+
+            // i915 exposes GT attributes on the card, xe under each tile and GT
+            std::string gt = path + "/device/tile0/gt0";
+            card.act_freq_fd = open_first({path + "/gt_act_freq_mhz", gt + "/freq0/act_freq"});
+            card.cur_freq_fd = open_first({path + "/gt_cur_freq_mhz", gt + "/freq0/cur_freq"});
+            card.rc6_fd = open_first({path + "/power/rc6_residency_ms", gt + "/gtidle/idle_residency_ms"});
+
+            std::error_code hwmon_ec;
+            for (const auto& hwmon : std::filesystem::directory_iterator(path + "/device/hwmon", hwmon_ec)) {
+                std::string hwmon_dir = hwmon.path().string();
+                card.energy_fd = open_first({hwmon_dir + "/energy1_input"});
+                card.power_limit_fd = open_first({hwmon_dir + "/power1_max"});
+                for (int sensor = 1; card.temp_fd < 0 && sensor <= 8; ++sensor) {
+                    card.temp_fd = open_first({hwmon_dir + "/temp" + std::to_string(sensor) + "_input"});
+                }
+                break;
+            }
+
+            debug_print("Added Intel GPU: " + path + " (" + driver + ")");
+            cards_.push_back(std::move(card));
+            initialized_ = true;
+        }
+        debug_print("Found " + std::to_string(cards_.size()) + " Intel GPUs");
+    } catch (const std::exception& e) {
+        debug_print("Error during initialization: " + std::string(e.what()));
+    }
+}
+
+IntelGPUDetector::~IntelGPUDetector() {
+    for (const auto& card : cards_) {
+        for (int fd : {card.act_freq_fd, card.cur_freq_fd, card.rc6_fd, card.energy_fd, card.power_limit_fd, card.temp_fd}) {
+            if (fd >= 0) close(fd);
+        }
+    }
+}
+
+bool IntelGPUDetector::is_available() const {
+    return initialized_;
+}
+
+std::vector<GPUInfo> IntelGPUDetector::get_gpu_info() const {
+    std::vector<GPUInfo> result;
+    if (!initialized_) return result;
+
+    std::lock_guard<std::mutex> lock(counters_mutex_);
+
+    std::vector<CounterSample> current;
+    for (const auto& card : cards_) {
+        current.push_back(read_counters(card));
+    }
+
+    // Cards without previous counters get a 100ms baseline, shared by all of them
+    bool needs_baseline = false;
+    for (size_t i = 0; i < cards_.size(); ++i) {
+        const CardHandles& card = cards_[i];
+        if ((current[i].rc6_ms && !card.previous_rc6_ms) || (current[i].energy_uj && !card.previous_energy_uj)) {
+            card.previous_rc6_ms = current[i].rc6_ms;
+            card.previous_energy_uj = current[i].energy_uj;
+            card.previous_timestamp = current[i].timestamp;
+            needs_baseline = true;
+        }
+    }
+    if (needs_baseline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        for (size_t i = 0; i < cards_.size(); ++i) {
+            current[i] = read_counters(cards_[i]);
+        }
+    }
+
+    for (size_t i = 0; i < cards_.size(); ++i) {
+        const CardHandles& card = cards_[i];
+        const CounterSample& now = current[i];
+
+        GPUInfo info{};
+        info.index = card.index;
+        info.name = card.name;
+        info.pci_bus_id = card.pdev;
+
+        if (auto act = read_number(card.act_freq_fd)) {
+            info.graphics_clock_mhz = static_cast<int32_t>(*act);
+        }
+        if (auto cur = read_number(card.cur_freq_fd)) {
+            info.requested_graphics_clock_mhz = static_cast<int32_t>(*cur);
+        }
+
+        // The GPU is busy whenever it is not in RC6
+        double elapsed_us = std::chrono::duration<double, std::micro>(now.timestamp - card.previous_timestamp).count();
+        if (now.rc6_ms && card.previous_rc6_ms && *now.rc6_ms >= *card.previous_rc6_ms && elapsed_us > 0) {
+            double idle_us = (*now.rc6_ms - *card.previous_rc6_ms) * 1000.0;
+            info.rc6_residency_percent = std::clamp(static_cast<float>(100.0 * idle_us / elapsed_us), 0.0f, 100.0f);
+            info.utilization_percent = 100.0f - info.rc6_residency_percent;
+        }
+
+        // Microjoules per microsecond are watts
+        if (now.energy_uj) {
+            info.energy_joules = *now.energy_uj / 1e6;
+            if (card.previous_energy_uj && *now.energy_uj >= *card.previous_energy_uj && elapsed_us > 0) {
+                info.power_draw_watts = static_cast<float>((*now.energy_uj - *card.previous_energy_uj) / elapsed_us);
+            }
+        }
+        if (auto limit = read_number(card.power_limit_fd)) {
+            info.power_limit_watts = *limit / 1e6f;
+        }
+        if (auto temp = read_number(card.temp_fd)) {
+            info.temperature_celsius = *temp / 1000.0f;
+        }
+
+        card.previous_rc6_ms = now.rc6_ms;
+        card.previous_energy_uj = now.energy_uj;
+        card.previous_timestamp = now.timestamp;
+
+        result.push_back(std::move(info));
+    }
+    return result;
+}
+
+std::vector<GPUProcessInfo> IntelGPUDetector::collect_processes(const std::function<bool(uint32_t)>& pid_filter) const {
+    std::vector<GPUProcessInfo> result;
+    for (const auto& usage : fdinfo_reader_.sample(pid_filter)) {
+        auto card = std::find_if(cards_.begin(), cards_.end(), [&usage](const CardHandles& c) {
+            return c.driver == usage.driver && c.pdev == usage.pdev;
+        });
+        if (card == cards_.end()) continue;
+
+        GPUProcessInfo proc_info{};
+        proc_info.pid = usage.pid;
+        proc_info.process_name = usage.process_name;
+        proc_info.gpu_index = card->index;
+
+        // Device-local memory (i915 local*, xe vram*) on discrete cards, everything on integrated ones
+        constexpr float mb_to_bytes = 1024.0f * 1024.0f;
+        float local_mb = 0;
+        float all_mb = 0;
+        for (const auto& [region, bytes] : usage.memory_bytes) {
+            all_mb += bytes / mb_to_bytes;
+            if (region.rfind("local", 0) == 0 || region.rfind("vram", 0) == 0) {
+                local_mb += bytes / mb_to_bytes;
+            }
+        }
+        proc_info.memory_usage_mb = local_mb > 0 ? local_mb : all_mb;
+
+        // Overall usage is the busiest engine
+        proc_info.engine_usage_percent = usage.engine_busy_percent;
+        for (const auto& [engine, percent] : usage.engine_busy_percent) {
+            proc_info.gpu_usage_percent = std::max(proc_info.gpu_usage_percent, percent);
+        }
+
+        debug_print("Process " + proc_info.process_name + " (PID: " + std::to_string(proc_info.pid) +
+                    ") GPU " + std::to_string(proc_info.gpu_index) + ": " +
+                    std::to_string(proc_info.gpu_usage_percent) + "%, " +
+                    std::to_string(proc_info.memory_usage_mb) + " MB");
+        result.push_back(std::move(proc_info));
+    }
+    return result;
+}
+
+std::optional<std::vector<GPUProcessInfo>> IntelGPUDetector::get_process_info(const std::string& process_name) const {
+    if (!initialized_) return std::nullopt;
+
+    // Check process name in multiple locations
+    auto result = collect_processes([this, &process_name](uint32_t pid) {
+        std::string proc_path = proc_root_ + "/" + std::to_string(pid);
+        std::string comm = read_file(proc_path + "/comm");
+        if (!comm.empty() && comm.find(process_name) != std::string::npos) return true;
+        std::string cmdline = read_file(proc_path + "/cmdline");
+        return !cmdline.empty() && cmdline.find(process_name) != std::string::npos;
+    });
+    return result.empty() ? std::nullopt : std::make_optional(result);
+}
+
+std::optional<std::vector<GPUProcessInfo>> IntelGPUDetector::get_process_info(uint32_t pid) const {
+    if (!initialized_) return std::nullopt;
+
+    auto result = collect_processes([pid](uint32_t candidate) { return candidate == pid; });
+    return result.empty() ? std::nullopt : std::make_optional(result);
+}
+
+std::optional<GPUInfo> IntelGPUDetector::get_gpu_info(uint32_t gpu_index) const {
+    auto all_gpus = get_gpu_info();
+    for (const auto& gpu : all_gpus) {
+        if (gpu.index == gpu_index) {
+            return gpu;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace hw_monitor
@@ -3,6 +3,7 @@
 #include <filesystem>
 #include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <chrono>
 #include <thread>
 #include <regex>
@@ -12,9 +13,113 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <cstring>
+#include <cerrno>
+#include <functional>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <tuple>
+#include <array>
+#include <limits>
+#include <mutex>
+#include <atomic>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/pkt_sched.h>
+#include <linux/gen_stats.h>
+#include <linux/sock_diag.h>
+#include <linux/inet_diag.h>
+#include <linux/unix_diag.h>
+#include <linux/tcp.h>
+#include <linux/ethtool.h>
+#include <linux/sockios.h>
 
 namespace hw_monitor {
 
+namespace {
+
+// TCP states as used by the kernel (include/net/tcp_states.h)
+constexpr uint8_t tcp_established = 1;
+constexpr uint8_t tcp_syn_sent = 2;
+constexpr uint8_t tcp_syn_recv = 3;
+constexpr uint8_t tcp_fin_wait1 = 4;
+constexpr uint8_t tcp_fin_wait2 = 5;
+constexpr uint8_t tcp_time_wait = 6;
+constexpr uint8_t tcp_close = 7;
+constexpr uint8_t tcp_close_wait = 8;
+constexpr uint8_t tcp_last_ack = 9;
+constexpr uint8_t tcp_listen = 10;
+constexpr uint8_t tcp_closing = 11;
+
+constexpr uint32_t tcp_state_flag(uint8_t state) {
+    return 1u << state;
+}
+
+// Connection states that carry meaningful tcp_info
+constexpr uint32_t tcp_connected_states =
+    tcp_state_flag(tcp_established) | tcp_state_flag(tcp_syn_sent) |
+    tcp_state_flag(tcp_fin_wait1) | tcp_state_flag(tcp_fin_wait2) |
+    tcp_state_flag(tcp_close_wait) | tcp_state_flag(tcp_last_ack) |
+    tcp_state_flag(tcp_closing);
+
+/**
+ * Weighted Space-Saving heavy-hitter sketch (Metwally et al.). Tracks at most
+ * `capacity` keys; when full, the smallest entry is replaced and its count is
+ * carried over as the new entry's error bound.
+ */
+template <typename Payload>
+class SpaceSavingSketch {
+public:
+    struct Entry {
+        uint64_t count;
+        uint64_t error;
+        Payload payload;
+    };
+
+    explicit SpaceSavingSketch(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+    Entry& add(const std::string& key, uint64_t weight) {
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            order_.erase({it->second.count, key});
+            it->second.count += weight;
+            order_.insert({it->second.count, key});
+            return it->second;
+        }
+
+        uint64_t base = 0;
+        if (entries_.size() >= capacity_) {
+            auto smallest = order_.begin();
+            base = smallest->first;
+            entries_.erase(smallest->second);
+            order_.erase(smallest);
+        }
+
+        auto& entry = entries_[key];
+        entry = Entry{base + weight, base, Payload{}};
+        order_.insert({entry.count, key});
+        return entry;
+    }
+
+    std::vector<std::pair<std::string, Entry>> top(size_t limit) const {
+        std::vector<std::pair<std::string, Entry>> result;
+        for (auto it = order_.rbegin(); it != order_.rend() && result.size() < limit; ++it) {
+            result.emplace_back(it->second, entries_.at(it->second));
+        }
+        return result;
+    }
+
+private:
+    size_t capacity_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::set<std::pair<uint64_t, std::string>> order_;
+};
+
+} // namespace
+
 class NetworkDetector::Impl {
 private:
     static std::string read_file(const std::string& path) {
@@ -25,9 +130,9 @@ private:
         return content;
     }
 
-    static std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> read_interface_stats() {
+    static std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> read_interface_stats(const std::string& path = "/proc/net/dev") {
         std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> stats;
-        std::ifstream proc_net("/proc/net/dev");
+        std::ifstream proc_net(path);
         std::string line;
 
         // Skip header lines
@@ -150,146 +255,1895 @@ private:
         return count;
     }
 
-public:
-    Impl() {}
+    /**
+     * Raw socket record as returned by an inet sock_diag dump
+     */
+    struct InetSocketSample {
+        uint8_t family;
+        uint8_t state;
+        std::array<uint8_t, 16> local_raw;
+        std::array<uint8_t, 16> remote_raw;
+        std::string local_address;
+        std::string remote_address;
+        uint16_t local_port;
+        uint16_t remote_port;
+        uint32_t inode;
+        uint32_t rqueue;
+        uint32_t wqueue;
+        uint64_t cookie;
+        bool has_tcp_info;
+        struct tcp_info tcp_info;
+    };
 
-    std::vector<NetworkInterfaceInfo> get_interface_info() const {
-        std::vector<NetworkInterfaceInfo> result;
+    /**
+     * Send a netlink dump request and invoke the callback for every reply message
+     */
+    static bool netlink_dump(int protocol, const void* request, size_t request_len,
+                             const std::function<void(const nlmsghdr*)>& on_message) {
+        int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, protocol);
+        if (fd == -1) return false;
 
-        // Get initial stats
-        auto initial_stats = read_interface_stats();
-        
-        // Wait a short time to calculate rate
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        
-        // Get updated stats
-        auto final_stats = read_interface_stats();
+        sockaddr_nl addr{};
+        addr.nl_family = AF_NETLINK;
+        if (sendto(fd, request, request_len, 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            close(fd);
+            return false;
+        }
 
-        for (const auto& [iface, stats] : final_stats) {
-            // Skip loopback interface
-            if (iface == "lo") continue;
+        std::vector<char> buffer(64 * 1024);
+        bool done = false;
+        bool ok = true;
+        while (!done) {
+            ssize_t len = recv(fd, buffer.data(), buffer.size(), 0);
+            if (len < 0) {
+                if (errno == EINTR) continue;
+                ok = false;
+                break;
+            }
+            if (len == 0) break;
 
-            NetworkInterfaceInfo info;
-            info.name = iface;
-            info.ip_address = get_ip_address(iface);
-            info.mac_address = get_mac_address(iface);
-            info.is_up = get_interface_status(iface);
-            info.mtu = get_interface_mtu(iface);
-            info.link_speed_mbps = get_link_speed(iface);
+            int remaining = static_cast<int>(len);
+            for (auto* nlh = reinterpret_cast<nlmsghdr*>(buffer.data()); NLMSG_OK(nlh, remaining);
+                 nlh = NLMSG_NEXT(nlh, remaining)) {
+                if (nlh->nlmsg_type == NLMSG_DONE) {
+                    done = true;
+                    break;
+                }
+                if (nlh->nlmsg_type == NLMSG_ERROR) {
+                    done = true;
+                    ok = false;
+                    break;
+                }
+                on_message(nlh);
+            }
+        }
 
-            // Calculate rates
-            float time_diff = 0.1f; // 100ms in seconds
-            info.total_received_bytes = stats.first;
-            info.total_transmitted_bytes = stats.second;
-            info.receive_bytes_per_sec = (stats.first - initial_stats[iface].first) / time_diff;
-            info.transmit_bytes_per_sec = (stats.second - initial_stats[iface].second) / time_diff;
+        close(fd);
+        return ok;
+    }
 
-            result.push_back(std::move(info));
+    /**
+     * Dump IPv4 and IPv6 sockets of a protocol in the given states via sock_diag
+     */
+    static std::vector<InetSocketSample> dump_inet_sockets(uint8_t protocol, uint32_t states, bool with_tcp_info) {
+        std::vector<InetSocketSample> result;
+
+        for (uint8_t family : {static_cast<uint8_t>(AF_INET), static_cast<uint8_t>(AF_INET6)}) {
+            struct {
+                nlmsghdr nlh;
+                inet_diag_req_v2 req;
+            } request{};
+            request.nlh.nlmsg_len = sizeof(request);
+            request.nlh.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+            request.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+            request.req.sdiag_family = family;
+            request.req.sdiag_protocol = protocol;
+            request.req.idiag_states = states;
+            if (with_tcp_info) {
+                request.req.idiag_ext = 1 << (INET_DIAG_INFO - 1);
+            }
+
+            netlink_dump(NETLINK_SOCK_DIAG, &request, sizeof(request), [&result](const nlmsghdr* nlh) {
+                if (nlh->nlmsg_type != SOCK_DIAG_BY_FAMILY) return;
+                if (nlh->nlmsg_len < NLMSG_LENGTH(sizeof(inet_diag_msg))) return;
+
+                const auto* msg = static_cast<const inet_diag_msg*>(NLMSG_DATA(nlh));
+                InetSocketSample sample{};
+                sample.family = msg->idiag_family;
+                sample.state = msg->idiag_state;
+                std::memcpy(sample.local_raw.data(), msg->id.idiag_src, sample.local_raw.size());
+                std::memcpy(sample.remote_raw.data(), msg->id.idiag_dst, sample.remote_raw.size());
+                sample.local_address = format_address(sample.family, sample.local_raw);
+                sample.remote_address = format_address(sample.family, sample.remote_raw);
+                sample.local_port = ntohs(msg->id.idiag_sport);
+                sample.remote_port = ntohs(msg->id.idiag_dport);
+                sample.inode = msg->idiag_inode;
+                sample.rqueue = msg->idiag_rqueue;
+                sample.wqueue = msg->idiag_wqueue;
+                sample.cookie = msg->id.idiag_cookie[0] | (static_cast<uint64_t>(msg->id.idiag_cookie[1]) << 32);
+
+                int attr_len = static_cast<int>(nlh->nlmsg_len - NLMSG_LENGTH(sizeof(*msg)));
+                for (auto* attr = reinterpret_cast<rtattr*>(const_cast<inet_diag_msg*>(msg) + 1);
+                     RTA_OK(attr, attr_len); attr = RTA_NEXT(attr, attr_len)) {
+                    if (attr->rta_type == INET_DIAG_INFO) {
+                        // Older kernels return a shorter tcp_info; the remainder stays zeroed
+                        size_t copy_len = std::min<size_t>(RTA_PAYLOAD(attr), sizeof(sample.tcp_info));
+                        std::memcpy(&sample.tcp_info, RTA_DATA(attr), copy_len);
+                        sample.has_tcp_info = true;
+                    }
+                }
+
+                result.push_back(std::move(sample));
+            });
         }
 
         return result;
     }
 
-    std::vector<std::string> get_interface_names() const {
-        std::vector<std::string> result;
-        for (const auto& entry : std::filesystem::directory_iterator("/sys/class/net")) {
-            std::string name = entry.path().filename();
-            if (name != "lo") { // Skip loopback interface
-                result.push_back(name);
-            }
+    static std::string format_address(uint8_t family, const std::array<uint8_t, 16>& raw) {
+        char buffer[INET6_ADDRSTRLEN] = {};
+        if (!inet_ntop(family, raw.data(), buffer, sizeof(buffer))) return "";
+        return buffer;
+    }
+
+    /**
+     * Format an address, with IPv4-mapped IPv6 addresses in their IPv4 form, so both ends of a
+     * connection between an IPv4 socket and a dual-stack IPv6 socket format the same
+     */
+    static std::string format_unmapped_address(uint8_t family, const std::array<uint8_t, 16>& raw) {
+        static constexpr std::array<uint8_t, 12> v4_mapped_prefix = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+        if (family == AF_INET6 && std::equal(v4_mapped_prefix.begin(), v4_mapped_prefix.end(), raw.begin())) {
+            std::array<uint8_t, 16> v4{};
+            std::copy(raw.begin() + 12, raw.end(), v4.begin());
+            return format_address(AF_INET, v4);
         }
-        return result;
+        return format_address(family, raw);
     }
 
-    std::optional<NetworkProcessInfo> get_process_info(uint32_t pid) const {
-        if (!std::filesystem::exists("/proc/" + std::to_string(pid))) {
-            return std::nullopt;
+    /**
+     * Format the remote subnet of an address: /24 for IPv4 (including IPv4-mapped IPv6), /64 for IPv6
+     */
+    static std::string format_subnet(uint8_t family, const std::array<uint8_t, 16>& raw) {
+        static constexpr std::array<uint8_t, 12> v4_mapped_prefix = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+        std::array<uint8_t, 16> masked{};
+
+        if (family == AF_INET6 && std::equal(v4_mapped_prefix.begin(), v4_mapped_prefix.end(), raw.begin())) {
+            std::copy(raw.begin() + 12, raw.begin() + 15, masked.begin());
+            return format_address(AF_INET, masked) + "/24";
         }
+        if (family == AF_INET) {
+            std::copy(raw.begin(), raw.begin() + 3, masked.begin());
+            return format_address(AF_INET, masked) + "/24";
+        }
+        std::copy(raw.begin(), raw.begin() + 8, masked.begin());
+        return format_address(AF_INET6, masked) + "/64";
+    }
 
-        NetworkProcessInfo info;
-        info.pid = pid;
-        info.process_name = read_file("/proc/" + std::to_string(pid) + "/comm");
-        if (!info.process_name.empty() && info.process_name.back() == '\n') {
-            info.process_name.pop_back();
+    /**
+     * Map socket inodes to the PID of a process holding them, from /proc/[pid]/fd
+     */
+    static std::unordered_map<uint32_t, uint32_t> build_socket_inode_index() {
+        std::unordered_map<uint32_t, uint32_t> index;
+        std::error_code ec;
+
+        for (const auto& entry : std::filesystem::directory_iterator("/proc", ec)) {
+            std::string pid_str = entry.path().filename().string();
+            if (pid_str.find_first_not_of("0123456789") != std::string::npos) continue;
+
+            uint32_t pid = std::stoul(pid_str);
+            std::error_code fd_ec;
+            for (const auto& fd : std::filesystem::directory_iterator(entry.path() / "fd", fd_ec)) {
+                std::error_code link_ec;
+                std::string target = std::filesystem::read_symlink(fd.path(), link_ec).string();
+                // Targets look like "socket:[12345]"
+                if (link_ec || target.compare(0, 8, "socket:[") != 0) continue;
+                try {
+                    index.emplace(std::stoul(target.substr(8)), pid);
+                } catch (...) {}
+            }
         }
 
-        // Get network statistics
-        info.active_connections = count_active_connections(pid);
-        info.ports = get_process_ports(pid);
+        return index;
+    }
 
-        // Calculate network rates
-        std::string net_path = "/proc/" + std::to_string(pid) + "/net/dev";
-        if (std::filesystem::exists(net_path)) {
-            // Get initial stats
-            auto initial_stats = read_interface_stats();
-            
-            // Wait a short time to calculate rate
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            
-            // Get updated stats
-            auto final_stats = read_interface_stats();
+    static std::string get_process_name(uint32_t pid) {
+        std::string name = read_file("/proc/" + std::to_string(pid) + "/comm");
+        if (!name.empty() && name.back() == '\n') {
+            name.pop_back();
+        }
+        return name;
+    }
 
-            // Sum up rates across all interfaces
-            float time_diff = 0.1f; // 100ms in seconds
-            uint64_t total_recv_diff = 0;
-            uint64_t total_trans_diff = 0;
+    /**
+     * Read counters from /proc/net/snmp and /proc/net/netstat keyed as "Group.Name" (e.g. "Tcp.RetransSegs")
+     */
+    static std::unordered_map<std::string, uint64_t> read_snmp_counters() {
+        std::unordered_map<std::string, uint64_t> counters;
 
-            for (const auto& [iface, stats] : final_stats) {
-                if (iface != "lo") { // Skip loopback
-                    total_recv_diff += stats.first - initial_stats[iface].first;
-                    total_trans_diff += stats.second - initial_stats[iface].second;
+        for (const char* path : {"/proc/net/snmp", "/proc/net/netstat"}) {
+            std::ifstream file(path);
+            std::string header, values;
+
+            // Each group is a pair of lines: names followed by values
+            while (std::getline(file, header) && std::getline(file, values)) {
+                std::istringstream header_iss(header);
+                std::istringstream values_iss(values);
+                std::string group, value_group;
+                header_iss >> group;
+                values_iss >> value_group;
+                if (group != value_group || group.empty()) continue;
+                group.pop_back();  // Strip trailing ':'
+
+                std::string name;
+                int64_t value;
+                while (header_iss >> name && values_iss >> value) {
+                    counters[group + "." + name] = static_cast<uint64_t>(value);
                 }
             }
+        }
 
-            info.receive_bytes_per_sec = total_recv_diff / time_diff;
-            info.transmit_bytes_per_sec = total_trans_diff / time_diff;
+        return counters;
+    }
+
+    static TCPStackCounters read_tcp_stack_counters() {
+        auto counters = read_snmp_counters();
+        TCPStackCounters result;
+        result.retrans_segs = counters["Tcp.RetransSegs"];
+        result.in_errs = counters["Tcp.InErrs"];
+        result.out_rsts = counters["Tcp.OutRsts"];
+        result.listen_overflows = counters["TcpExt.ListenOverflows"];
+        result.listen_drops = counters["TcpExt.ListenDrops"];
+        result.tcp_timeouts = counters["TcpExt.TCPTimeouts"];
+        result.lost_retransmits = counters["TcpExt.TCPLostRetransmit"];
+        result.fast_retransmits = counters["TcpExt.TCPFastRetrans"];
+        result.slow_start_retransmits = counters["TcpExt.TCPSlowStartRetrans"];
+        result.syn_retransmits = counters["TcpExt.TCPSynRetrans"];
+        result.backlog_drops = counters["TcpExt.TCPBacklogDrop"];
+        return result;
+    }
+
+    /**
+     * Collect the socket inodes held by a single process
+     */
+    static std::unordered_set<uint32_t> get_process_socket_inodes(uint32_t pid) {
+        std::unordered_set<uint32_t> inodes;
+        std::error_code ec;
+        for (const auto& fd : std::filesystem::directory_iterator("/proc/" + std::to_string(pid) + "/fd", ec)) {
+            std::error_code link_ec;
+            std::string target = std::filesystem::read_symlink(fd.path(), link_ec).string();
+            if (link_ec || target.compare(0, 8, "socket:[") != 0) continue;
+            try {
+                inodes.insert(std::stoul(target.substr(8)));
+            } catch (...) {}
+        }
+        return inodes;
+    }
+
+    /**
+     * Receive and send queue bytes of every queued socket, by socket inode
+     */
+    static std::unordered_map<uint32_t, std::pair<uint64_t, uint64_t>> read_queue_bytes_by_inode() {
+        std::unordered_map<uint32_t, std::pair<uint64_t, uint64_t>> queues;
+        for (const auto& [protocol, sock] : dump_queued_sockets()) {
+            auto& queue = queues[sock.inode];
+            queue.first += sock.rqueue;
+            queue.second += sock.wqueue;
+        }
+        return queues;
+    }
+
+    /**
+     * Dump sockets whose queues are meaningful: established TCP and all UDP sockets
+     */
+    static std::vector<std::pair<std::string, InetSocketSample>> dump_queued_sockets() {
+        std::vector<std::pair<std::string, InetSocketSample>> result;
+        for (auto& sock : dump_inet_sockets(IPPROTO_TCP, tcp_state_flag(tcp_established), false)) {
+            result.emplace_back("tcp", std::move(sock));
+        }
+        // Unconnected UDP sockets are reported in the CLOSE state
+        for (auto& sock : dump_inet_sockets(IPPROTO_UDP, tcp_state_flag(tcp_established) | tcp_state_flag(tcp_close), false)) {
+            result.emplace_back("udp", std::move(sock));
+        }
+        return result;
+    }
+
+    static SocketMemoryInfo read_socket_memory_info() {
+        SocketMemoryInfo info{};
+        const uint64_t page_size = sysconf(_SC_PAGESIZE);
+        std::ifstream sockstat("/proc/net/sockstat");
+        std::string line;
+
+        // Lines look like "TCP: inuse 5 orphan 0 tw 2 alloc 7 mem 1"
+        while (std::getline(sockstat, line)) {
+            std::istringstream iss(line);
+            std::string group, key;
+            uint64_t value;
+            iss >> group;
+            while (iss >> key >> value) {
+                if (group == "sockets:" && key == "used") info.sockets_used = value;
+                else if (group == "TCP:" && key == "inuse") info.tcp_in_use = value;
+                else if (group == "TCP:" && key == "orphan") info.tcp_orphaned = value;
+                else if (group == "TCP:" && key == "tw") info.tcp_time_wait = value;
+                else if (group == "TCP:" && key == "alloc") info.tcp_allocated = value;
+                else if (group == "TCP:" && key == "mem") info.tcp_memory_bytes = value * page_size;
+                else if (group == "UDP:" && key == "inuse") info.udp_in_use = value;
+                else if (group == "UDP:" && key == "mem") info.udp_memory_bytes = value * page_size;
+            }
         }
 
         return info;
     }
 
-    std::optional<std::vector<NetworkProcessInfo>> get_process_info(const std::string& process_name) const {
-        std::vector<NetworkProcessInfo> result;
+    /**
+     * Read driver statistics (ethtool -S) of an interface keyed by name
+     */
+    static std::unordered_map<std::string, uint64_t> read_ethtool_stats(const std::string& interface) {
+        std::unordered_map<std::string, uint64_t> stats;
+        int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd == -1) return stats;
 
-        for (const auto& entry : std::filesystem::directory_iterator("/proc")) {
-            if (!std::filesystem::is_directory(entry.path())) continue;
+        struct ifreq ifr{};
+        std::strncpy(ifr.ifr_name, interface.c_str(), IFNAMSIZ - 1);
+
+        // Query the number of statistics
+        alignas(ethtool_sset_info) char sset_buffer[sizeof(ethtool_sset_info) + sizeof(uint32_t)] = {};
+        auto* sset = reinterpret_cast<ethtool_sset_info*>(sset_buffer);
+        sset->cmd = ETHTOOL_GSSET_INFO;
+        sset->sset_mask = 1ULL << ETH_SS_STATS;
+        ifr.ifr_data = reinterpret_cast<char*>(sset);
+        if (ioctl(fd, SIOCETHTOOL, &ifr) != 0 || !(sset->sset_mask & (1ULL << ETH_SS_STATS))) {
+            close(fd);
+            return stats;
+        }
+        uint32_t count = sset->data[0];
+        if (count == 0) {
+            close(fd);
+            return stats;
+        }
+
+        std::vector<uint64_t> strings_buffer((sizeof(ethtool_gstrings) + count * ETH_GSTRING_LEN) / sizeof(uint64_t) + 1);
+        auto* strings = reinterpret_cast<ethtool_gstrings*>(strings_buffer.data());
+        strings->cmd = ETHTOOL_GSTRINGS;
+        strings->string_set = ETH_SS_STATS;
+        strings->len = count;
+        ifr.ifr_data = reinterpret_cast<char*>(strings);
+        if (ioctl(fd, SIOCETHTOOL, &ifr) != 0) {
+            close(fd);
+            return stats;
+        }
+
+        std::vector<uint64_t> values_buffer(sizeof(ethtool_stats) / sizeof(uint64_t) + count + 1);
+        auto* values = reinterpret_cast<ethtool_stats*>(values_buffer.data());
+        values->cmd = ETHTOOL_GSTATS;
+        values->n_stats = count;
+        ifr.ifr_data = reinterpret_cast<char*>(values);
+        if (ioctl(fd, SIOCETHTOOL, &ifr) == 0) {
+            for (uint32_t i = 0; i < count; ++i) {
+                const char* name = reinterpret_cast<const char*>(strings->data) + i * ETH_GSTRING_LEN;
+                stats[std::string(name, strnlen(name, ETH_GSTRING_LEN))] = values->data[i];
+            }
+        }
+
+        close(fd);
+        return stats;
+    }
+
+    /**
+     * Recognise per-queue byte/packet counters across driver naming schemes, e.g.
+     * "rx_queue_0_bytes" (virtio, ixgbe), "rx0_packets" (mlx5), "queue_0_tx_bytes" (ena)
+     * and "tx-1.bytes". Returns the sysfs queue name ("rx-0") and whether it counts bytes.
+     */
+    static bool parse_queue_stat_name(const std::string& name, std::string& queue, bool& is_bytes) {
+        std::vector<std::string> tokens;
+        std::string token;
+        for (char c : name) {
+            if (c == '_' || c == '-' || c == '.') {
+                if (!token.empty()) tokens.push_back(std::move(token));
+                token.clear();
+            } else {
+                token += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+        }
+        if (!token.empty()) tokens.push_back(std::move(token));
+        if (tokens.size() < 2) return false;
+
+        if (tokens.back() == "bytes") is_bytes = true;
+        else if (tokens.back() == "packets") is_bytes = false;
+        else return false;
+        tokens.pop_back();
+
+        std::string direction;
+        std::string index;
+        auto is_number = [](const std::string& value) {
+            return !value.empty() && value.find_first_not_of("0123456789") == std::string::npos;
+        };
+
+        // Any token besides direction, "queue" and the index (e.g. "xdp", "drop") disqualifies the counter
+        for (const auto& t : tokens) {
+            if ((t == "rx" || t == "tx") && direction.empty()) {
+                direction = t;
+            } else if ((t.compare(0, 2, "rx") == 0 || t.compare(0, 2, "tx") == 0) && is_number(t.substr(2)) &&
+                       direction.empty() && index.empty()) {
+                direction = t.substr(0, 2);
+                index = t.substr(2);
+            } else if (t == "queue") {
+                continue;
+            } else if (is_number(t) && index.empty()) {
+                index = t;
+            } else {
+                return false;
+            }
+        }
+
+        if (direction.empty() || index.empty()) return false;
+        queue = direction + "-" + std::to_string(std::stoul(index));
+        return true;
+    }
+
+    /**
+     * Per-queue (bytes, packets) counters of an interface keyed by sysfs queue name
+     */
+    static std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> read_queue_counters(const std::string& interface) {
+        std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> counters;
+        for (const auto& [name, value] : read_ethtool_stats(interface)) {
+            std::string queue;
+            bool is_bytes = false;
+            if (!parse_queue_stat_name(name, queue, is_bytes)) continue;
+            auto& entry = counters[queue];
+            (is_bytes ? entry.first : entry.second) = value;
+        }
+        return counters;
+    }
+
+    static std::map<uint32_t, SoftnetCPUStats> read_softnet_stats() {
+        std::map<uint32_t, SoftnetCPUStats> stats;
+        std::ifstream softnet("/proc/net/softnet_stat");
+        std::string line;
+        uint32_t line_index = 0;
+
+        while (std::getline(softnet, line)) {
+            std::istringstream iss(line);
+            std::vector<uint64_t> columns;
+            std::string column;
+            while (iss >> column) {
+                columns.push_back(std::stoull(column, nullptr, 16));
+            }
+            if (columns.size() < 10) continue;
+
+            SoftnetCPUStats cpu_stats{};
+            // Kernels since 5.10 print the CPU index in column 13; older ones only list online CPUs in order
+            cpu_stats.cpu = columns.size() > 12 ? static_cast<uint32_t>(columns[12]) : line_index;
+            cpu_stats.processed = columns[0];
+            cpu_stats.dropped = columns[1];
+            cpu_stats.time_squeeze = columns[2];
+            cpu_stats.received_rps = columns[9];
+            cpu_stats.flow_limit_count = columns.size() > 10 ? columns[10] : 0;
+            stats[cpu_stats.cpu] = cpu_stats;
+            line_index++;
+        }
+
+        return stats;
+    }
+
+    static std::string tcp_state_name(uint8_t state) {
+        static const char* names[] = {
+            "UNKNOWN", "ESTABLISHED", "SYN_SENT", "SYN_RECV", "FIN_WAIT1", "FIN_WAIT2",
+            "TIME_WAIT", "CLOSE", "CLOSE_WAIT", "LAST_ACK", "LISTEN", "CLOSING"
+        };
+        return state < std::size(names) ? names[state] : names[0];
+    }
 
+    /**
+     * Parse an "ADDRESS:PORT" pair from /proc/net/tcp{,6}; the address is printed as native-endian 32-bit words
+     */
+    static std::pair<std::string, uint16_t> parse_proc_net_address(const std::string& field) {
+        size_t colon_pos = field.find(':');
+        if (colon_pos == std::string::npos) return {"", 0};
+
+        std::string hex = field.substr(0, colon_pos);
+        uint16_t port = std::stoul(field.substr(colon_pos + 1), nullptr, 16);
+
+        std::array<uint8_t, 16> raw{};
+        size_t words = hex.size() / 8;
+        for (size_t i = 0; i < words && i < 4; ++i) {
+            uint32_t word = std::stoul(hex.substr(i * 8, 8), nullptr, 16);
+            std::memcpy(raw.data() + i * 4, &word, sizeof(word));
+        }
+        return {format_address(words == 1 ? AF_INET : AF_INET6, raw), port};
+    }
+
+    static std::vector<NamespaceSocketInfo> read_proc_net_tcp(const std::string& pid_dir,
+                                                              const std::unordered_map<uint32_t, uint32_t>& inode_index) {
+        std::vector<NamespaceSocketInfo> sockets;
+
+        for (const char* file_name : {"/net/tcp", "/net/tcp6"}) {
+            std::ifstream file(pid_dir + file_name);
+            std::string line;
+            std::getline(file, line);  // Skip header
+
+            while (std::getline(file, line)) {
+                std::istringstream iss(line);
+                std::string sl, local_addr, rem_addr, state, queues, tr, retrnsmt, uid, timeout;
+                uint32_t inode = 0;
+                if (!(iss >> sl >> local_addr >> rem_addr >> state >> queues >> tr >> retrnsmt >> uid >> timeout >> inode)) continue;
+
+                try {
+                    NamespaceSocketInfo sock;
+                    std::tie(sock.local_address, sock.local_port) = parse_proc_net_address(local_addr);
+                    std::tie(sock.remote_address, sock.remote_port) = parse_proc_net_address(rem_addr);
+                    sock.state = tcp_state_name(static_cast<uint8_t>(std::stoul(state, nullptr, 16)));
+                    auto owner = inode_index.find(inode);
+                    sock.pid = owner != inode_index.end() ? owner->second : 0;
+                    sockets.push_back(std::move(sock));
+                } catch (...) {}
+            }
+        }
+
+        return sockets;
+    }
+
+    /**
+     * Group processes by network namespace inode
+     */
+    static std::map<uint64_t, std::vector<uint32_t>> enumerate_network_namespaces() {
+        std::map<uint64_t, std::vector<uint32_t>> namespaces;
+        std::error_code ec;
+
+        for (const auto& entry : std::filesystem::directory_iterator("/proc", ec)) {
             std::string pid_str = entry.path().filename().string();
             if (pid_str.find_first_not_of("0123456789") != std::string::npos) continue;
 
-            try {
-                uint32_t pid = std::stoul(pid_str);
-                std::string comm = read_file(entry.path().string() + "/comm");
-                if (!comm.empty() && comm.find(process_name) != std::string::npos) {
-                    if (auto proc_info = get_process_info(pid)) {
-                        result.push_back(*proc_info);
-                    }
-                }
-            } catch (...) {}
+            struct stat ns_stat;
+            if (stat((entry.path() / "ns/net").c_str(), &ns_stat) != 0) continue;
+            namespaces[ns_stat.st_ino].push_back(std::stoul(pid_str));
         }
 
-        return result.empty() ? std::nullopt : std::make_optional(result);
+        return namespaces;
     }
-};
 
-// Implement the public interface
-NetworkDetector::NetworkDetector() : pimpl_(std::make_unique<Impl>()) {}
-NetworkDetector::~NetworkDetector() = default;
+    /**
+     * Parse /proc/net/stat/nf_conntrack: a header of column names followed by one hex line per CPU
+     */
+    static std::vector<ConntrackCPUStats> read_conntrack_stats() {
+        std::vector<ConntrackCPUStats> stats;
+        std::ifstream file("/proc/net/stat/nf_conntrack");
+        std::string line;
+        if (!std::getline(file, line)) return stats;
 
-std::optional<NetworkProcessInfo> NetworkDetector::get_process_info(uint32_t pid) const {
-    return pimpl_->get_process_info(pid);
-}
+        // Column sets differ between kernel versions, so locate them by name
+        std::unordered_map<std::string, size_t> columns;
+        std::istringstream header(line);
+        std::string name;
+        for (size_t i = 0; header >> name; ++i) {
+            columns[name] = i;
+        }
 
-std::optional<std::vector<NetworkProcessInfo>> NetworkDetector::get_process_info(const std::string& process_name) const {
-    return pimpl_->get_process_info(process_name);
-}
+        auto column_value = [&columns](const std::vector<uint64_t>& values, const std::string& column) -> uint64_t {
+            auto it = columns.find(column);
+            return it != columns.end() && it->second < values.size() ? values[it->second] : 0;
+        };
 
-std::vector<NetworkInterfaceInfo> NetworkDetector::get_interface_info() const {
-    return pimpl_->get_interface_info();
-}
+        uint32_t cpu = 0;
+        while (std::getline(file, line)) {
+            std::istringstream iss(line);
+            std::vector<uint64_t> values;
+            std::string value;
+            while (iss >> value) {
+                values.push_back(std::stoull(value, nullptr, 16));
+            }
 
-std::vector<std::string> NetworkDetector::get_interface_names() const {
-    return pimpl_->get_interface_names();
+            ConntrackCPUStats cpu_stats{};
+            cpu_stats.cpu = cpu++;
+            cpu_stats.insert_failed = column_value(values, "insert_failed");
+            cpu_stats.drop = column_value(values, "drop");
+            cpu_stats.early_drop = column_value(values, "early_drop");
+            cpu_stats.search_restart = column_value(values, "search_restart");
+            stats.push_back(cpu_stats);
+        }
+
+        return stats;
+    }
+
+    static std::string format_tc_handle(uint32_t handle) {
+        if (handle == TC_H_ROOT) return "root";
+        if (handle == TC_H_INGRESS) return "ingress";
+        std::ostringstream oss;
+        oss << std::hex << (TC_H_MAJ(handle) >> 16) << ":" << TC_H_MIN(handle);
+        return oss.str();
+    }
+
+    /**
+     * Dump qdiscs (RTM_GETQDISC) or classes (RTM_GETTCLASS) of an interface; ifindex 0 dumps all qdiscs
+     */
+    static std::vector<QdiscInfo> dump_tc_objects(uint16_t message_type, int ifindex) {
+        std::vector<QdiscInfo> result;
+
+        struct {
+            nlmsghdr nlh;
+            tcmsg tcm;
+        } request{};
+        request.nlh.nlmsg_len = sizeof(request);
+        request.nlh.nlmsg_type = message_type;
+        request.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+        request.tcm.tcm_family = AF_UNSPEC;
+        request.tcm.tcm_ifindex = ifindex;
+
+        netlink_dump(NETLINK_ROUTE, &request, sizeof(request), [&result](const nlmsghdr* nlh) {
+            if (nlh->nlmsg_type != RTM_NEWQDISC && nlh->nlmsg_type != RTM_NEWTCLASS) return;
+            if (nlh->nlmsg_len < NLMSG_LENGTH(sizeof(tcmsg))) return;
+
+            const auto* tcm = static_cast<const tcmsg*>(NLMSG_DATA(nlh));
+            char ifname[IF_NAMESIZE] = {};
+            if (!if_indextoname(tcm->tcm_ifindex, ifname)) return;
+
+            QdiscInfo info{};
+            info.interface = ifname;
+            info.is_class = nlh->nlmsg_type == RTM_NEWTCLASS;
+            info.handle = format_tc_handle(tcm->tcm_handle);
+            info.parent = format_tc_handle(tcm->tcm_parent);
+
+            bool has_stats2 = false;
+            int attr_len = static_cast<int>(nlh->nlmsg_len - NLMSG_LENGTH(sizeof(*tcm)));
+            for (auto* attr = reinterpret_cast<rtattr*>(const_cast<tcmsg*>(tcm) + 1);
+                 RTA_OK(attr, attr_len); attr = RTA_NEXT(attr, attr_len)) {
+                if (attr->rta_type == TCA_KIND) {
+                    info.kind = static_cast<const char*>(RTA_DATA(attr));
+                } else if (attr->rta_type == TCA_STATS2) {
+                    has_stats2 = true;
+                    int nested_len = static_cast<int>(RTA_PAYLOAD(attr));
+                    for (auto* nested = static_cast<rtattr*>(RTA_DATA(attr)); RTA_OK(nested, nested_len);
+                         nested = RTA_NEXT(nested, nested_len)) {
+                        if (nested->rta_type == TCA_STATS_BASIC) {
+                            gnet_stats_basic basic{};
+                            std::memcpy(&basic, RTA_DATA(nested), std::min<size_t>(RTA_PAYLOAD(nested), sizeof(basic)));
+                            info.bytes = basic.bytes;
+                            // Only the low 32 bits; the kernel follows with TCA_STATS_PKT64 once the count exceeds them
+                            info.packets = basic.packets;
+                        } else if (nested->rta_type == TCA_STATS_PKT64) {
+                            std::memcpy(&info.packets, RTA_DATA(nested), std::min<size_t>(RTA_PAYLOAD(nested), sizeof(info.packets)));
+                        } else if (nested->rta_type == TCA_STATS_QUEUE) {
+                            gnet_stats_queue queue{};
+                            std::memcpy(&queue, RTA_DATA(nested), std::min<size_t>(RTA_PAYLOAD(nested), sizeof(queue)));
+                            info.queue_length = queue.qlen;
+                            info.backlog_bytes = queue.backlog;
+                            info.drops = queue.drops;
+                            info.requeues = queue.requeues;
+                            info.overlimits = queue.overlimits;
+                        }
+                    }
+                } else if (attr->rta_type == TCA_STATS && !has_stats2) {
+                    // Legacy statistics, only used when TCA_STATS2 is absent
+                    tc_stats stats{};
+                    std::memcpy(&stats, RTA_DATA(attr), std::min<size_t>(RTA_PAYLOAD(attr), sizeof(stats)));
+                    info.bytes = stats.bytes;
+                    info.packets = stats.packets;
+                    info.drops = stats.drops;
+                    info.overlimits = stats.overlimits;
+                    info.queue_length = stats.qlen;
+                    info.backlog_bytes = stats.backlog;
+                }
+            }
+
+            result.push_back(std::move(info));
+        });
+
+        return result;
+    }
+
+    /**
+     * Qdiscs and classes of the monitored interfaces keyed by interface, object type and handle
+     */
+    std::map<std::string, QdiscInfo> read_tc_stats(const std::vector<std::string>& interfaces) const {
+        std::map<std::string, QdiscInfo> result;
+        auto add = [&result](QdiscInfo&& info) {
+            std::string key = info.interface + (info.is_class ? "/class/" : "/qdisc/") + info.handle + "/" + info.parent;
+            result[key] = std::move(info);
+        };
+
+        std::unordered_set<std::string> monitored(interfaces.begin(), interfaces.end());
+        for (auto& qdisc : dump_tc_objects(RTM_GETQDISC, 0)) {
+            if (monitored.count(qdisc.interface)) add(std::move(qdisc));
+        }
+        for (const auto& iface : interfaces) {
+            int ifindex = if_nametoindex(iface.c_str());
+            if (ifindex == 0) continue;
+            for (auto& tc_class : dump_tc_objects(RTM_GETTCLASS, ifindex)) {
+                add(std::move(tc_class));
+            }
+        }
+
+        return result;
+    }
+
+    static std::string get_interface_driver(const std::string& interface) {
+        int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd == -1) return "";
+
+        struct ifreq ifr{};
+        std::strncpy(ifr.ifr_name, interface.c_str(), IFNAMSIZ - 1);
+        ethtool_drvinfo drvinfo{};
+        drvinfo.cmd = ETHTOOL_GDRVINFO;
+        ifr.ifr_data = reinterpret_cast<char*>(&drvinfo);
+
+        std::string driver;
+        if (ioctl(fd, SIOCETHTOOL, &ifr) == 0) {
+            driver = std::string(drvinfo.driver, strnlen(drvinfo.driver, sizeof(drvinfo.driver)));
+        }
+        close(fd);
+        return driver;
+    }
+
+    /**
+     * Resolve master, lower and upper devices from /sys/class/net/<if>/{master,lower_*,upper_*}
+     */
+    static InterfaceTopologyInfo get_interface_topology(const std::string& interface) {
+        InterfaceTopologyInfo info{};
+        info.name = interface;
+        std::string base = "/sys/class/net/" + interface;
+
+        std::error_code ec;
+        info.is_physical = std::filesystem::exists(base + "/device", ec);
+        auto master = std::filesystem::read_symlink(base + "/master", ec);
+        if (!ec) info.master = master.filename().string();
+
+        for (const auto& entry : std::filesystem::directory_iterator(base, ec)) {
+            std::string name = entry.path().filename().string();
+            if (name.compare(0, 6, "lower_") == 0) info.lower_devices.push_back(name.substr(6));
+            else if (name.compare(0, 6, "upper_") == 0) info.upper_devices.push_back(name.substr(6));
+        }
+
+        // Stacked devices announce their type in uevent; otherwise fall back to the driver name
+        std::ifstream uevent(base + "/uevent");
+        std::string line;
+        while (std::getline(uevent, line)) {
+            if (line.compare(0, 8, "DEVTYPE=") == 0) {
+                info.kind = line.substr(8);
+                break;
+            }
+        }
+        if (info.kind.empty()) {
+            if (std::filesystem::exists(base + "/bonding", ec)) info.kind = "bond";
+            else if (std::filesystem::exists(base + "/bridge", ec)) info.kind = "bridge";
+            else info.kind = get_interface_driver(interface);
+        }
+
+        return info;
+    }
+
+    static bool read_counter_fd(int fd, uint64_t& value) {
+        char buffer[32];
+        ssize_t len = pread(fd, buffer, sizeof(buffer) - 1, 0);
+        if (len <= 0) return false;
+        buffer[len] = '\0';
+        value = std::strtoull(buffer, nullptr, 10);
+        return true;
+    }
+
+    void microburst_loop(uint32_t sample_interval_us) {
+        using clock = std::chrono::steady_clock;
+        auto interval = std::chrono::microseconds(sample_interval_us);
+        auto last_time = clock::now();
+        auto next_time = last_time + interval;
+
+        float interval_sec = std::chrono::duration<float>(interval).count();
+
+        while (microburst_running_.load(std::memory_order_relaxed)) {
+            std::this_thread::sleep_until(next_time);
+
+            // After an oversleep, resync rather than running catch-up iterations back to back
+            auto now = clock::now();
+            next_time += interval;
+            if (now > next_time) next_time = now + interval;
+
+            // A much shorter window than the interval makes the rates noisy; let it roll into the next sample
+            float elapsed_sec = std::chrono::duration<float>(now - last_time).count();
+            if (elapsed_sec < interval_sec / 2) continue;
+            last_time = now;
+
+            std::lock_guard<std::mutex> lock(microburst_mutex_);
+            for (auto& channel : microburst_channels_) {
+                uint64_t rx = 0, tx = 0;
+                if (!read_counter_fd(channel.rx_fd, rx) || !read_counter_fd(channel.tx_fd, tx)) continue;
+
+                float rx_mbps = (rx - channel.last_rx) * 8.0f / elapsed_sec / 1e6f;
+                float tx_mbps = (tx - channel.last_tx) * 8.0f / elapsed_sec / 1e6f;
+                channel.last_rx = rx;
+                channel.last_tx = tx;
+
+                auto& info = channel.info;
+                float utilization = info.link_speed_mbps > 0 ? std::max(rx_mbps, tx_mbps) * 100.0f / info.link_speed_mbps : 0.0f;
+                size_t bucket = std::min<size_t>(static_cast<size_t>(utilization / 10.0f), info.utilization_histogram.size() - 1);
+
+                info.samples++;
+                info.utilization_histogram[bucket]++;
+                info.peak_receive_mbps = std::max(info.peak_receive_mbps, rx_mbps);
+                info.peak_transmit_mbps = std::max(info.peak_transmit_mbps, tx_mbps);
+                info.peak_utilization_percent = std::max(info.peak_utilization_percent, utilization);
+
+                bool above = info.link_speed_mbps > 0 && utilization >= microburst_threshold_percent_;
+                if (above && !channel.in_burst) info.burst_count++;
+                channel.in_burst = above;
+            }
+        }
+    }
+
+    /**
+     * Dump connected UNIX sockets as (inode, peer inode) pairs
+     */
+    static std::vector<std::pair<uint32_t, uint32_t>> dump_unix_socket_peers() {
+        std::vector<std::pair<uint32_t, uint32_t>> peers;
+
+        struct {
+            nlmsghdr nlh;
+            unix_diag_req req;
+        } request{};
+        request.nlh.nlmsg_len = sizeof(request);
+        request.nlh.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+        request.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+        request.req.sdiag_family = AF_UNIX;
+        request.req.udiag_states = ~0u;
+        request.req.udiag_show = UDIAG_SHOW_PEER;
+
+        netlink_dump(NETLINK_SOCK_DIAG, &request, sizeof(request), [&peers](const nlmsghdr* nlh) {
+            if (nlh->nlmsg_type != SOCK_DIAG_BY_FAMILY) return;
+            if (nlh->nlmsg_len < NLMSG_LENGTH(sizeof(unix_diag_msg))) return;
+
+            const auto* msg = static_cast<const unix_diag_msg*>(NLMSG_DATA(nlh));
+            int attr_len = static_cast<int>(nlh->nlmsg_len - NLMSG_LENGTH(sizeof(*msg)));
+            for (auto* attr = reinterpret_cast<rtattr*>(const_cast<unix_diag_msg*>(msg) + 1);
+                 RTA_OK(attr, attr_len); attr = RTA_NEXT(attr, attr_len)) {
+                if (attr->rta_type == UNIX_DIAG_PEER && RTA_PAYLOAD(attr) >= sizeof(uint32_t)) {
+                    uint32_t peer = 0;
+                    std::memcpy(&peer, RTA_DATA(attr), sizeof(peer));
+                    if (peer != 0) peers.emplace_back(msg->udiag_ino, peer);
+                }
+            }
+        });
+
+        return peers;
+    }
+
+    static bool is_loopback(uint8_t family, const std::array<uint8_t, 16>& raw) {
+        static constexpr std::array<uint8_t, 12> v4_mapped_prefix = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+        static constexpr std::array<uint8_t, 16> v6_loopback = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+        if (family == AF_INET) return raw[0] == 127;
+        if (std::equal(v4_mapped_prefix.begin(), v4_mapped_prefix.end(), raw.begin())) return raw[12] == 127;
+        return raw == v6_loopback;
+    }
+
+    static void add_to_summary(TCPHealthSummary& summary, const TCPConnectionInfo& conn) {
+        summary.connection_count++;
+        summary.average_rtt_ms += conn.rtt_ms;
+        summary.average_rtt_var_ms += conn.rtt_var_ms;
+        summary.max_rtt_ms = std::max(summary.max_rtt_ms, conn.rtt_ms);
+        summary.total_retransmits += conn.retransmits;
+        summary.total_lost += conn.lost;
+        summary.total_delivery_rate_bytes_per_sec += conn.delivery_rate_bytes_per_sec;
+        summary.busy_time_us += conn.busy_time_us;
+        summary.rwnd_limited_us += conn.rwnd_limited_us;
+        summary.sndbuf_limited_us += conn.sndbuf_limited_us;
+    }
+
+    static std::vector<TCPHealthSummary> finish_summaries(std::map<std::string, TCPHealthSummary>& groups) {
+        std::vector<TCPHealthSummary> result;
+        result.reserve(groups.size());
+        for (auto& [key, summary] : groups) {
+            summary.key = key;
+            summary.average_rtt_ms /= summary.connection_count;
+            summary.average_rtt_var_ms /= summary.connection_count;
+            result.push_back(std::move(summary));
+        }
+        return result;
+    }
+
+    mutable std::mutex state_mutex_;                                        ///< Guards state kept between calls
+    mutable std::unordered_map<uint64_t, uint32_t> listen_saturation_streaks_; ///< Saturated sample streak per listener cookie
+    mutable std::unordered_map<uint32_t, uint32_t> previous_close_wait_;       ///< CLOSE_WAIT count per PID at the previous call
+
+    /**
+     * State of one interface sampled by the microburst monitor
+     */
+    struct MicroburstChannel {
+        int rx_fd;
+        int tx_fd;
+        uint64_t last_rx;
+        uint64_t last_tx;
+        bool in_burst;
+        MicroburstInfo info;
+    };
+
+    std::thread microburst_thread_;                 ///< Sampling thread
+    std::atomic<bool> microburst_running_{false};   ///< Signals the sampling thread to keep going
+    mutable std::mutex microburst_mutex_;           ///< Guards microburst_channels_
+    mutable std::vector<MicroburstChannel> microburst_channels_;   ///< Sampled interfaces and their running statistics
+    float microburst_threshold_percent_ = 0.0f;     ///< Utilization above which a sample is part of a burst
+
+public:
+    Impl() {}
+
+    ~Impl() {
+        stop_microburst_monitor();
+    }
+
+    std::vector<NetworkInterfaceInfo> get_interface_info() const {
+        std::vector<NetworkInterfaceInfo> result;
+
+        // Get initial stats
+        auto initial_stats = read_interface_stats();
+        
+        // Wait a short time to calculate rate
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        
+        // Get updated stats
+        auto final_stats = read_interface_stats();
+
+        for (const auto& [iface, stats] : final_stats) {
+            // Skip loopback interface
+            if (iface == "lo") continue;
+
+            NetworkInterfaceInfo info;
+            info.name = iface;
+            info.ip_address = get_ip_address(iface);
+            info.mac_address = get_mac_address(iface);
+            info.is_up = get_interface_status(iface);
+            info.mtu = get_interface_mtu(iface);
+            info.link_speed_mbps = get_link_speed(iface);
+
+            // Calculate rates
+            float time_diff = 0.1f; // 100ms in seconds
+            info.total_received_bytes = stats.first;
+            info.total_transmitted_bytes = stats.second;
+            info.receive_bytes_per_sec = (stats.first - initial_stats[iface].first) / time_diff;
+            info.transmit_bytes_per_sec = (stats.second - initial_stats[iface].second) / time_diff;
+
+            result.push_back(std::move(info));
+        }
+
+        return result;
+    }
+
+    std::vector<std::string> get_interface_names() const {
+        std::vector<std::string> result;
+        for (const auto& entry : std::filesystem::directory_iterator("/sys/class/net")) {
+            std::string name = entry.path().filename();
+            if (name != "lo") { // Skip loopback interface
+                result.push_back(name);
+            }
+        }
+        return result;
+    }
+
+    std::optional<NetworkProcessInfo> get_process_info(uint32_t pid) const {
+        return build_process_info(pid, read_queue_bytes_by_inode());
+    }
+
+    /**
+     * Network information of one process, with socket queue occupancy looked up in a
+     * socket dump shared by all processes of one public call
+     */
+    std::optional<NetworkProcessInfo> build_process_info(
+            uint32_t pid, const std::unordered_map<uint32_t, std::pair<uint64_t, uint64_t>>& queues_by_inode) const {
+        if (!std::filesystem::exists("/proc/" + std::to_string(pid))) {
+            return std::nullopt;
+        }
+
+        NetworkProcessInfo info;
+        info.pid = pid;
+        info.process_name = read_file("/proc/" + std::to_string(pid) + "/comm");
+        if (!info.process_name.empty() && info.process_name.back() == '\n') {
+            info.process_name.pop_back();
+        }
+
+        // Get network statistics
+        info.active_connections = count_active_connections(pid);
+        info.ports = get_process_ports(pid);
+
+        // Sum socket queue occupancy over the sockets this process holds
+        info.receive_queue_bytes = 0;
+        info.send_queue_bytes = 0;
+        for (uint32_t inode : get_process_socket_inodes(pid)) {
+            auto queue = queues_by_inode.find(inode);
+            if (queue != queues_by_inode.end()) {
+                info.receive_queue_bytes += queue->second.first;
+                info.send_queue_bytes += queue->second.second;
+            }
+        }
+
+        // Calculate network rates
+        std::string net_path = "/proc/" + std::to_string(pid) + "/net/dev";
+        if (std::filesystem::exists(net_path)) {
+            // Get initial stats
+            auto initial_stats = read_interface_stats();
+            
+            // Wait a short time to calculate rate
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            
+            // Get updated stats
+            auto final_stats = read_interface_stats();
+
+            // Sum up rates across all interfaces
+            float time_diff = 0.1f; // 100ms in seconds
+            uint64_t total_recv_diff = 0;
+            uint64_t total_trans_diff = 0;
+
+            for (const auto& [iface, stats] : final_stats) {
+                if (iface != "lo") { // Skip loopback
+                    total_recv_diff += stats.first - initial_stats[iface].first;
+                    total_trans_diff += stats.second - initial_stats[iface].second;
+                }
+            }
+
+            info.receive_bytes_per_sec = total_recv_diff / time_diff;
+            info.transmit_bytes_per_sec = total_trans_diff / time_diff;
+        }
+
+        return info;
+    }
+
+    std::optional<std::vector<NetworkProcessInfo>> get_process_info(const std::string& process_name) const {
+        std::vector<NetworkProcessInfo> result;
+        // One socket dump for all matching processes, taken at the first match
+        std::optional<std::unordered_map<uint32_t, std::pair<uint64_t, uint64_t>>> queues_by_inode;
+
+        for (const auto& entry : std::filesystem::directory_iterator("/proc")) {
+            if (!std::filesystem::is_directory(entry.path())) continue;
+
+            std::string pid_str = entry.path().filename().string();
+            if (pid_str.find_first_not_of("0123456789") != std::string::npos) continue;
+
+            try {
+                uint32_t pid = std::stoul(pid_str);
+                std::string comm = read_file(entry.path().string() + "/comm");
+                if (!comm.empty() && comm.find(process_name) != std::string::npos) {
+                    if (!queues_by_inode) queues_by_inode = read_queue_bytes_by_inode();
+                    if (auto proc_info = build_process_info(pid, *queues_by_inode)) {
+                        result.push_back(*proc_info);
+                    }
+                }
+            } catch (...) {}
+        }
+
+        return result.empty() ? std::nullopt : std::make_optional(result);
+    }
+
+    TCPHealthReport get_tcp_health() const {
+        TCPHealthReport report;
+
+        auto sockets = dump_inet_sockets(IPPROTO_TCP, tcp_connected_states, true);
+        auto inode_index = build_socket_inode_index();
+        std::unordered_map<uint32_t, std::string> process_names;
+        std::map<std::string, TCPHealthSummary> by_process;
+        std::map<std::string, TCPHealthSummary> by_subnet;
+
+        report.connections.reserve(sockets.size());
+        for (const auto& sock : sockets) {
+            if (!sock.has_tcp_info) continue;
+
+            TCPConnectionInfo conn;
+            conn.local_address = sock.local_address;
+            conn.local_port = sock.local_port;
+            conn.remote_address = sock.remote_address;
+            conn.remote_port = sock.remote_port;
+
+            auto owner = inode_index.find(sock.inode);
+            conn.pid = owner != inode_index.end() ? owner->second : 0;
+            if (conn.pid != 0) {
+                auto [it, inserted] = process_names.try_emplace(conn.pid);
+                if (inserted) it->second = get_process_name(conn.pid);
+                conn.process_name = it->second;
+            }
+
+            const auto& ti = sock.tcp_info;
+            conn.rtt_ms = ti.tcpi_rtt / 1000.0f;
+            conn.rtt_var_ms = ti.tcpi_rttvar / 1000.0f;
+            conn.retransmits = ti.tcpi_total_retrans;
+            conn.lost = ti.tcpi_lost;
+            conn.congestion_window = ti.tcpi_snd_cwnd;
+            conn.delivery_rate_bytes_per_sec = ti.tcpi_delivery_rate;
+            conn.busy_time_us = ti.tcpi_busy_time;
+            conn.rwnd_limited_us = ti.tcpi_rwnd_limited;
+            conn.sndbuf_limited_us = ti.tcpi_sndbuf_limited;
+
+            if (conn.pid != 0) {
+                auto& summary = by_process[conn.process_name + " (" + std::to_string(conn.pid) + ")"];
+                summary.pid = conn.pid;
+                add_to_summary(summary, conn);
+            }
+            add_to_summary(by_subnet[format_subnet(sock.family, sock.remote_raw)], conn);
+
+            report.connections.push_back(std::move(conn));
+        }
+
+        report.by_process = finish_summaries(by_process);
+        report.by_remote_subnet = finish_summaries(by_subnet);
+        report.counters = read_tcp_stack_counters();
+        return report;
+    }
+
+    ListenQueueReport get_listen_queue_info(float threshold_percent, uint32_t sustained_samples) const {
+        ListenQueueReport report;
+
+        auto initial_counters = read_snmp_counters();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto final_counters = read_snmp_counters();
+
+        float time_diff = 0.1f; // 100ms in seconds
+        report.listen_overflows = final_counters["TcpExt.ListenOverflows"];
+        report.listen_drops = final_counters["TcpExt.ListenDrops"];
+        report.listen_overflows_per_sec = (report.listen_overflows - initial_counters["TcpExt.ListenOverflows"]) / time_diff;
+        report.listen_drops_per_sec = (report.listen_drops - initial_counters["TcpExt.ListenDrops"]) / time_diff;
+
+        // For listening sockets rqueue is the accept queue length and wqueue the backlog
+        auto sockets = dump_inet_sockets(IPPROTO_TCP, tcp_state_flag(tcp_listen), false);
+        auto inode_index = build_socket_inode_index();
+
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        std::unordered_map<uint64_t, uint32_t> streaks;
+
+        for (const auto& sock : sockets) {
+            ListenSocketInfo info;
+            info.address = sock.local_address;
+            info.port = sock.local_port;
+            auto owner = inode_index.find(sock.inode);
+            info.pid = owner != inode_index.end() ? owner->second : 0;
+            info.process_name = info.pid != 0 ? get_process_name(info.pid) : "";
+            info.accept_queue_depth = sock.rqueue;
+            info.backlog = sock.wqueue;
+            info.fill_percent = info.backlog > 0 ? (info.accept_queue_depth * 100.0f) / info.backlog : 0.0f;
+
+            uint32_t streak = 0;
+            if (info.fill_percent >= threshold_percent) {
+                auto previous = listen_saturation_streaks_.find(sock.cookie);
+                streak = (previous != listen_saturation_streaks_.end() ? previous->second : 0) + 1;
+            }
+            streaks[sock.cookie] = streak;
+            info.saturated_samples = streak;
+            // A listener has to be saturated at least once to alert, even with sustained_samples 0
+            info.alert = streak >= std::max(1u, sustained_samples);
+
+            report.listeners.push_back(std::move(info));
+        }
+
+        // Listeners that disappeared are dropped from the streak table
+        listen_saturation_streaks_ = std::move(streaks);
+        return report;
+    }
+
+    SocketBufferReport get_socket_buffer_info() const {
+        SocketBufferReport report;
+
+        auto sockets = dump_queued_sockets();
+        auto inode_index = build_socket_inode_index();
+        std::unordered_map<uint32_t, ProcessSocketQueueInfo> processes;
+
+        for (const auto& [protocol, sock] : sockets) {
+            auto owner = inode_index.find(sock.inode);
+            if (owner == inode_index.end()) continue;
+
+            auto [it, inserted] = processes.try_emplace(owner->second);
+            auto& proc = it->second;
+            if (inserted) {
+                proc.pid = owner->second;
+                proc.process_name = get_process_name(proc.pid);
+            }
+
+            SocketQueueInfo queue;
+            queue.protocol = protocol;
+            queue.local_address = sock.local_address;
+            queue.local_port = sock.local_port;
+            queue.remote_address = sock.remote_address;
+            queue.remote_port = sock.remote_port;
+            queue.receive_queue_bytes = sock.rqueue;
+            queue.send_queue_bytes = sock.wqueue;
+
+            proc.socket_count++;
+            proc.receive_queue_bytes += sock.rqueue;
+            proc.send_queue_bytes += sock.wqueue;
+            proc.sockets.push_back(std::move(queue));
+        }
+
+        report.processes.reserve(processes.size());
+        for (auto& [pid, proc] : processes) {
+            report.processes.push_back(std::move(proc));
+        }
+
+        // Slow consumers first
+        std::sort(report.processes.begin(), report.processes.end(),
+                  [](const ProcessSocketQueueInfo& a, const ProcessSocketQueueInfo& b) {
+                      return a.receive_queue_bytes > b.receive_queue_bytes;
+                  });
+
+        report.memory = read_socket_memory_info();
+        return report;
+    }
+
+    std::vector<NICQueueInfo> get_nic_queue_info() const {
+        std::vector<NICQueueInfo> result;
+        auto interfaces = get_interface_names();
+
+        std::unordered_map<std::string, std::unordered_map<std::string, std::pair<uint64_t, uint64_t>>> initial_counters;
+        for (const auto& iface : interfaces) {
+            initial_counters[iface] = read_queue_counters(iface);
+        }
+
+        // Wait a short time to calculate rate
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        for (const auto& iface : interfaces) {
+            auto final_counters = read_queue_counters(iface);
+            const auto& initial = initial_counters[iface];
+
+            std::vector<std::string> queues;
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator("/sys/class/net/" + iface + "/queues", ec)) {
+                queues.push_back(entry.path().filename().string());
+            }
+            std::sort(queues.begin(), queues.end());
+
+            for (const auto& queue : queues) {
+                NICQueueInfo info{};
+                info.interface = iface;
+                info.queue = queue;
+                info.is_rx = queue.compare(0, 3, "rx-") == 0;
+
+                std::string queue_path = "/sys/class/net/" + iface + "/queues/" + queue;
+                info.cpu_mask = read_file(queue_path + (info.is_rx ? "/rps_cpus" : "/xps_cpus"));
+
+                auto counter = final_counters.find(queue);
+                if (counter != final_counters.end()) {
+                    float time_diff = 0.1f; // 100ms in seconds
+                    auto previous = initial.find(queue);
+                    auto start = previous != initial.end() ? previous->second : counter->second;
+                    info.has_counters = true;
+                    info.bytes = counter->second.first;
+                    info.packets = counter->second.second;
+                    // Drivers reset their ring counters when queues are reconfigured; skip that window
+                    if (info.bytes >= start.first && info.packets >= start.second) {
+                        info.bytes_per_sec = (info.bytes - start.first) / time_diff;
+                        info.packets_per_sec = (info.packets - start.second) / time_diff;
+                    }
+                }
+
+                result.push_back(std::move(info));
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<SoftnetCPUStats> get_softnet_stats() const {
+        std::vector<SoftnetCPUStats> result;
+
+        auto initial_stats = read_softnet_stats();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto final_stats = read_softnet_stats();
+
+        float time_diff = 0.1f; // 100ms in seconds
+        for (auto& [cpu, stats] : final_stats) {
+            auto previous = initial_stats.find(cpu);
+            if (previous != initial_stats.end()) {
+                // Counters are 32-bit in the kernel and wrap around
+                auto delta = [](uint64_t now, uint64_t before) {
+                    return static_cast<uint32_t>(now - before);
+                };
+                stats.processed_per_sec = delta(stats.processed, previous->second.processed) / time_diff;
+                stats.dropped_per_sec = delta(stats.dropped, previous->second.dropped) / time_diff;
+                stats.time_squeeze_per_sec = delta(stats.time_squeeze, previous->second.time_squeeze) / time_diff;
+                stats.received_rps_per_sec = delta(stats.received_rps, previous->second.received_rps) / time_diff;
+            }
+            result.push_back(stats);
+        }
+
+        return result;
+    }
+
+    std::vector<NetworkNamespaceInfo> get_namespace_info() const {
+        std::vector<NetworkNamespaceInfo> result;
+
+        auto namespaces = enumerate_network_namespaces();
+        struct stat own_stat;
+        uint64_t own_inode = stat("/proc/self/ns/net", &own_stat) == 0 ? own_stat.st_ino : 0;
+
+        // One representative process per namespace; /proc/[pid]/net reflects that process's namespace.
+        // Any process still holding the namespace will do, as earlier ones may exit after enumeration.
+        // Every live namespace has "lo", so an empty result means the process is gone.
+        using InterfaceStats = std::unordered_map<std::string, std::pair<uint64_t, uint64_t>>;
+        auto read_namespace_stats = [](const std::vector<uint32_t>& pids, std::string& ns_dir) {
+            for (uint32_t pid : pids) {
+                std::string dir = "/proc/" + std::to_string(pid);
+                auto stats = read_interface_stats(dir + "/net/dev");
+                if (!stats.empty()) {
+                    ns_dir = dir;
+                    return stats;
+                }
+            }
+            return InterfaceStats{};
+        };
+
+        std::vector<std::string> ns_dirs;
+        std::vector<InterfaceStats> initial_stats;
+        for (const auto& [inode, pids] : namespaces) {
+            ns_dirs.emplace_back();
+            initial_stats.push_back(read_namespace_stats(pids, ns_dirs.back()));
+        }
+
+        // Wait a short time to calculate rate
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        auto inode_index = build_socket_inode_index();
+        std::unordered_map<uint32_t, std::string> process_names;
+
+        size_t ns_pos = 0;
+        for (const auto& [inode, pids] : namespaces) {
+            auto& ns_dir = ns_dirs[ns_pos];
+            auto& initial = initial_stats[ns_pos];
+            ns_pos++;
+
+            NetworkNamespaceInfo ns_info;
+            ns_info.inode = inode;
+            ns_info.is_own_namespace = inode == own_inode;
+            ns_info.pids = pids;
+
+            float time_diff = 0.1f; // 100ms in seconds
+            for (const auto& [iface, stats] : read_namespace_stats(pids, ns_dir)) {
+                if (iface == "lo") continue;
+
+                NetworkInterfaceInfo info{};
+                info.name = iface;
+                if (ns_info.is_own_namespace) {
+                    info.ip_address = get_ip_address(iface);
+                    info.mac_address = get_mac_address(iface);
+                    info.is_up = get_interface_status(iface);
+                    info.mtu = get_interface_mtu(iface);
+                    info.link_speed_mbps = get_link_speed(iface);
+                }
+                info.total_received_bytes = stats.first;
+                info.total_transmitted_bytes = stats.second;
+                auto previous = initial.count(iface) ? initial[iface] : stats;
+                info.receive_bytes_per_sec = (stats.first - previous.first) / time_diff;
+                info.transmit_bytes_per_sec = (stats.second - previous.second) / time_diff;
+                ns_info.interfaces.push_back(std::move(info));
+            }
+
+            if (ns_dir.empty()) {
+                // Every process of the namespace exited meanwhile
+                result.push_back(std::move(ns_info));
+                continue;
+            }
+            ns_info.sockets = read_proc_net_tcp(ns_dir, inode_index);
+            for (auto& sock : ns_info.sockets) {
+                if (sock.pid == 0) continue;
+                auto [it, inserted] = process_names.try_emplace(sock.pid);
+                if (inserted) it->second = get_process_name(sock.pid);
+                sock.process_name = it->second;
+            }
+
+            result.push_back(std::move(ns_info));
+        }
+
+        return result;
+    }
+
+    std::optional<ConntrackInfo> get_conntrack_info(float warn_percent) const {
+        std::string count_str = read_file("/proc/sys/net/netfilter/nf_conntrack_count");
+        std::string max_str = read_file("/proc/sys/net/netfilter/nf_conntrack_max");
+        if (count_str.empty() || max_str.empty()) {
+            return std::nullopt;
+        }
+
+        auto initial_stats = read_conntrack_stats();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto final_stats = read_conntrack_stats();
+
+        ConntrackInfo info{};
+        info.count = std::stoull(count_str);
+        info.max = std::stoull(max_str);
+        info.usage_percent = info.max > 0 ? (info.count * 100.0f) / info.max : 0.0f;
+        info.near_capacity = info.usage_percent >= warn_percent;
+
+        float time_diff = 0.1f; // 100ms in seconds
+        for (size_t i = 0; i < final_stats.size(); ++i) {
+            auto cpu_stats = final_stats[i];
+            if (i < initial_stats.size()) {
+                const auto& previous = initial_stats[i];
+                // Counters are 32-bit in the kernel and wrap around
+                auto rate = [time_diff](uint64_t now, uint64_t before) {
+                    return static_cast<uint32_t>(now - before) / time_diff;
+                };
+                cpu_stats.insert_failed_per_sec = rate(cpu_stats.insert_failed, previous.insert_failed);
+                cpu_stats.drop_per_sec = rate(cpu_stats.drop, previous.drop);
+                cpu_stats.early_drop_per_sec = rate(cpu_stats.early_drop, previous.early_drop);
+                cpu_stats.search_restart_per_sec = rate(cpu_stats.search_restart, previous.search_restart);
+            }
+
+            info.insert_failed_per_sec += cpu_stats.insert_failed_per_sec;
+            info.drop_per_sec += cpu_stats.drop_per_sec;
+            info.early_drop_per_sec += cpu_stats.early_drop_per_sec;
+            info.search_restart_per_sec += cpu_stats.search_restart_per_sec;
+            info.per_cpu.push_back(cpu_stats);
+        }
+
+        return info;
+    }
+
+    std::vector<QdiscInfo> get_qdisc_info() const {
+        std::vector<QdiscInfo> result;
+        auto interfaces = get_interface_names();
+
+        auto initial_stats = read_tc_stats(interfaces);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto final_stats = read_tc_stats(interfaces);
+
+        float time_diff = 0.1f; // 100ms in seconds
+        for (auto& [key, info] : final_stats) {
+            auto previous = initial_stats.find(key);
+            if (previous != initial_stats.end()) {
+                const auto& before = previous->second;
+                info.bytes_per_sec = (info.bytes - before.bytes) / time_diff;
+                // 32-bit counts wrap (kernels without TCA_STATS_PKT64); full 64-bit ones only grow
+                constexpr uint64_t max_u32 = std::numeric_limits<uint32_t>::max();
+                uint64_t packets = info.packets > max_u32 || before.packets > max_u32
+                    ? (info.packets >= before.packets ? info.packets - before.packets : 0)
+                    : static_cast<uint32_t>(info.packets - before.packets);
+                info.packets_per_sec = packets / time_diff;
+                info.drops_per_sec = static_cast<uint32_t>(info.drops - before.drops) / time_diff;
+                info.overlimits_per_sec = static_cast<uint32_t>(info.overlimits - before.overlimits) / time_diff;
+                info.requeues_per_sec = static_cast<uint32_t>(info.requeues - before.requeues) / time_diff;
+            }
+            result.push_back(std::move(info));
+        }
+
+        return result;
+    }
+
+    TCPChurnReport get_tcp_churn(uint32_t close_wait_threshold) const {
+        TCPChurnReport report{};
+
+        auto initial_counters = read_snmp_counters();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto final_counters = read_snmp_counters();
+
+        float time_diff = 0.1f; // 100ms in seconds
+        auto rate = [&](const std::string& name) {
+            return (final_counters[name] - initial_counters[name]) / time_diff;
+        };
+        report.active_opens_per_sec = rate("Tcp.ActiveOpens");
+        report.passive_opens_per_sec = rate("Tcp.PassiveOpens");
+        report.attempt_fails_per_sec = rate("Tcp.AttemptFails");
+        report.estab_resets_per_sec = rate("Tcp.EstabResets");
+        report.out_rsts_per_sec = rate("Tcp.OutRsts");
+        report.current_established = final_counters["Tcp.CurrEstab"];
+
+        auto sockets = dump_inet_sockets(IPPROTO_TCP,
+            tcp_state_flag(tcp_time_wait) | tcp_state_flag(tcp_close_wait) |
+            tcp_state_flag(tcp_syn_recv) | tcp_state_flag(tcp_listen), false);
+        auto inode_index = build_socket_inode_index();
+
+        // Listener owner by local port and address, used to attribute SYN_RECV request sockets
+        std::map<std::pair<uint16_t, std::string>, uint32_t> listener_owners;
+        for (const auto& sock : sockets) {
+            if (sock.state != tcp_listen) continue;
+            auto owner = inode_index.find(sock.inode);
+            if (owner != inode_index.end()) {
+                listener_owners[{sock.local_port, sock.local_address}] = owner->second;
+            }
+        }
+        auto find_listener_owner = [&listener_owners](const InetSocketSample& sock) -> uint32_t {
+            // IPv4 requests may also be accepted by a dual-stack IPv6 listener
+            std::vector<std::string> candidates = {sock.local_address};
+            if (sock.family == AF_INET) {
+                candidates.insert(candidates.end(), {"0.0.0.0", "::ffff:" + sock.local_address, "::ffff:0.0.0.0", "::"});
+            } else {
+                candidates.push_back("::");
+            }
+            for (const auto& address : candidates) {
+                auto it = listener_owners.find({sock.local_port, address});
+                if (it != listener_owners.end()) return it->second;
+            }
+            return 0;
+        };
+
+        std::unordered_map<uint32_t, ProcessTCPStateInfo> processes;
+        for (const auto& sock : sockets) {
+            uint32_t pid = 0;
+            if (sock.state == tcp_time_wait) {
+                report.system.time_wait++;
+            } else if (sock.state == tcp_close_wait) {
+                report.system.close_wait++;
+                auto owner = inode_index.find(sock.inode);
+                pid = owner != inode_index.end() ? owner->second : 0;
+                if (pid != 0) processes[pid].close_wait++;
+            } else if (sock.state == tcp_syn_recv) {
+                report.system.syn_recv++;
+                pid = find_listener_owner(sock);
+                if (pid != 0) processes[pid].syn_recv++;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        std::unordered_map<uint32_t, uint32_t> close_wait_counts;
+        for (auto& [pid, proc] : processes) {
+            proc.pid = pid;
+            proc.process_name = get_process_name(pid);
+            auto previous = previous_close_wait_.find(pid);
+            proc.close_wait_delta = previous != previous_close_wait_.end()
+                ? static_cast<int32_t>(proc.close_wait) - static_cast<int32_t>(previous->second) : 0;
+            proc.close_wait_leak_suspected = proc.close_wait >= close_wait_threshold && proc.close_wait_delta >= 0;
+            close_wait_counts[pid] = proc.close_wait;
+            report.processes.push_back(std::move(proc));
+        }
+        previous_close_wait_ = std::move(close_wait_counts);
+
+        std::sort(report.processes.begin(), report.processes.end(),
+                  [](const ProcessTCPStateInfo& a, const ProcessTCPStateInfo& b) {
+                      return a.close_wait > b.close_wait;
+                  });
+
+        return report;
+    }
+
+    std::vector<TopTalkerInfo> get_top_talkers(TalkerGrouping grouping, size_t limit, size_t sketch_capacity) const {
+        std::vector<TopTalkerInfo> result;
+
+        auto initial_sockets = dump_inet_sockets(IPPROTO_TCP, tcp_connected_states, true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto final_sockets = dump_inet_sockets(IPPROTO_TCP, tcp_connected_states, true);
+
+        std::unordered_map<uint64_t, std::pair<uint64_t, uint64_t>> initial_bytes;
+        for (const auto& sock : initial_sockets) {
+            if (sock.has_tcp_info) {
+                initial_bytes[sock.cookie] = {sock.tcp_info.tcpi_bytes_received, sock.tcp_info.tcpi_bytes_acked};
+            }
+        }
+
+        struct PeerTraffic {
+            uint64_t received;
+            uint64_t transmitted;
+            uint32_t connections;
+            std::vector<uint32_t> inodes;
+        };
+        constexpr size_t max_inodes_per_peer = 16;
+        SpaceSavingSketch<PeerTraffic> sketch(sketch_capacity);
+
+        for (const auto& sock : final_sockets) {
+            if (!sock.has_tcp_info) continue;
+
+            // Sockets opened during the window contribute everything they carried
+            auto previous = initial_bytes.find(sock.cookie);
+            uint64_t received = sock.tcp_info.tcpi_bytes_received;
+            uint64_t transmitted = sock.tcp_info.tcpi_bytes_acked;
+            if (previous != initial_bytes.end()) {
+                received -= previous->second.first;
+                transmitted -= previous->second.second;
+            }
+            if (received + transmitted == 0) continue;
+
+            std::string key;
+            switch (grouping) {
+                case TalkerGrouping::RemoteAddress: key = sock.remote_address; break;
+                case TalkerGrouping::RemoteSubnet: key = format_subnet(sock.family, sock.remote_raw); break;
+                case TalkerGrouping::RemotePort: key = std::to_string(sock.remote_port); break;
+            }
+
+            auto& entry = sketch.add(key, received + transmitted);
+            entry.payload.received += received;
+            entry.payload.transmitted += transmitted;
+            entry.payload.connections++;
+            if (entry.payload.inodes.size() < max_inodes_per_peer) {
+                entry.payload.inodes.push_back(sock.inode);
+            }
+        }
+
+        auto top = sketch.top(limit);
+        if (top.empty()) return result;
+
+        // Only resolve owners for the peers that made it into the report
+        auto inode_index = build_socket_inode_index();
+        float time_diff = 0.1f; // 100ms in seconds
+        for (const auto& [key, entry] : top) {
+            TopTalkerInfo info{};
+            info.peer = key;
+            info.receive_bytes_per_sec = entry.payload.received / time_diff;
+            info.transmit_bytes_per_sec = entry.payload.transmitted / time_diff;
+            info.total_bytes_per_sec = entry.count / time_diff;
+            info.error_bytes_per_sec = entry.error / time_diff;
+            info.connection_count = entry.payload.connections;
+
+            for (uint32_t inode : entry.payload.inodes) {
+                auto owner = inode_index.find(inode);
+                if (owner == inode_index.end()) continue;
+                if (std::find(info.pids.begin(), info.pids.end(), owner->second) != info.pids.end()) continue;
+                info.pids.push_back(owner->second);
+                info.process_names.push_back(get_process_name(owner->second));
+            }
+
+            result.push_back(std::move(info));
+        }
+
+        return result;
+    }
+
+    NetworkTrafficSummary get_traffic_summary() const {
+        NetworkTrafficSummary summary{};
+
+        auto initial_stats = read_interface_stats();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto final_stats = read_interface_stats();
+
+        float time_diff = 0.1f; // 100ms in seconds
+        for (const auto& [iface, stats] : final_stats) {
+            if (iface == "lo") continue;
+
+            auto info = get_interface_topology(iface);
+            auto previous = initial_stats.count(iface) ? initial_stats[iface] : stats;
+            info.receive_bytes_per_sec = (stats.first - previous.first) / time_diff;
+            info.transmit_bytes_per_sec = (stats.second - previous.second) / time_diff;
+
+            // Bond masters, VLANs and bridges repeat traffic that their physical lower devices already carry,
+            // and a stack of virtual devices repeats it at every layer; only the top of each stack counts
+            if (info.is_physical) {
+                summary.physical_receive_bytes_per_sec += info.receive_bytes_per_sec;
+                summary.physical_transmit_bytes_per_sec += info.transmit_bytes_per_sec;
+            } else if (info.upper_devices.empty() && info.master.empty()) {
+                summary.virtual_receive_bytes_per_sec += info.receive_bytes_per_sec;
+                summary.virtual_transmit_bytes_per_sec += info.transmit_bytes_per_sec;
+            }
+
+            summary.interfaces.push_back(std::move(info));
+        }
+
+        std::sort(summary.interfaces.begin(), summary.interfaces.end(),
+                  [](const InterfaceTopologyInfo& a, const InterfaceTopologyInfo& b) {
+                      return a.name < b.name;
+                  });
+        return summary;
+    }
+
+    bool start_microburst_monitor(const std::vector<std::string>& interfaces, uint32_t sample_interval_us,
+                                  float burst_threshold_percent) {
+        stop_microburst_monitor();
+
+        // Shorter intervals are dominated by counter read overhead
+        sample_interval_us = std::max<uint32_t>(sample_interval_us, 100);
+
+        std::vector<MicroburstChannel> channels;
+        for (const auto& iface : interfaces) {
+            std::string stats_path = "/sys/class/net/" + iface + "/statistics/";
+            MicroburstChannel channel{};
+            channel.rx_fd = open((stats_path + "rx_bytes").c_str(), O_RDONLY | O_CLOEXEC);
+            channel.tx_fd = open((stats_path + "tx_bytes").c_str(), O_RDONLY | O_CLOEXEC);
+            if (channel.rx_fd == -1 || channel.tx_fd == -1 ||
+                !read_counter_fd(channel.rx_fd, channel.last_rx) || !read_counter_fd(channel.tx_fd, channel.last_tx)) {
+                if (channel.rx_fd != -1) close(channel.rx_fd);
+                if (channel.tx_fd != -1) close(channel.tx_fd);
+                continue;
+            }
+
+            channel.info.interface = iface;
+            channel.info.link_speed_mbps = std::max(get_link_speed(iface), 0.0f);
+            channel.info.sample_interval_us = sample_interval_us;
+            channels.push_back(std::move(channel));
+        }
+        if (channels.empty()) return false;
+
+        {
+            std::lock_guard<std::mutex> lock(microburst_mutex_);
+            microburst_channels_ = std::move(channels);
+            microburst_threshold_percent_ = burst_threshold_percent;
+        }
+
+        microburst_running_ = true;
+        microburst_thread_ = std::thread(&Impl::microburst_loop, this, sample_interval_us);
+        return true;
+    }
+
+    void stop_microburst_monitor() {
+        microburst_running_ = false;
+        if (microburst_thread_.joinable()) {
+            microburst_thread_.join();
+        }
+
+        std::lock_guard<std::mutex> lock(microburst_mutex_);
+        for (auto& channel : microburst_channels_) {
+            close(channel.rx_fd);
+            close(channel.tx_fd);
+        }
+        microburst_channels_.clear();
+    }
+
+    std::vector<MicroburstInfo> get_microburst_info() const {
+        std::vector<MicroburstInfo> result;
+        std::lock_guard<std::mutex> lock(microburst_mutex_);
+
+        // Report the interval since the previous call and start a new one
+        for (auto& channel : microburst_channels_) {
+            result.push_back(channel.info);
+
+            auto& info = channel.info;
+            info.samples = 0;
+            info.peak_utilization_percent = 0.0f;
+            info.peak_receive_mbps = 0.0f;
+            info.peak_transmit_mbps = 0.0f;
+            info.burst_count = 0;
+            info.utilization_histogram.fill(0);
+        }
+
+        return result;
+    }
+
+    std::vector<ProcessCommunicationEdge> get_process_communication_graph() const {
+        std::vector<ProcessCommunicationEdge> result;
+
+        auto initial_sockets = dump_inet_sockets(IPPROTO_TCP, tcp_state_flag(tcp_established), true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto final_sockets = dump_inet_sockets(IPPROTO_TCP, tcp_state_flag(tcp_established), true);
+        auto unix_peers = dump_unix_socket_peers();
+
+        // One socket-inode -> PID index per cycle serves both transports
+        auto inode_index = build_socket_inode_index();
+        auto owner_of = [&inode_index](uint32_t inode) -> uint32_t {
+            auto it = inode_index.find(inode);
+            return it != inode_index.end() ? it->second : 0;
+        };
+
+        std::map<std::tuple<uint32_t, uint32_t, std::string>, ProcessCommunicationEdge> edges;
+        auto add_edge = [&edges](uint32_t pid_a, uint32_t pid_b, const std::string& transport, float bytes_per_sec) {
+            if (pid_a == 0 || pid_b == 0 || pid_a == pid_b) return;
+            if (pid_a > pid_b) std::swap(pid_a, pid_b);
+            auto& edge = edges[{pid_a, pid_b, transport}];
+            edge.pid_a = pid_a;
+            edge.pid_b = pid_b;
+            edge.transport = transport;
+            edge.connection_count++;
+            edge.bytes_per_sec += bytes_per_sec;
+        };
+
+        // A pair may be reported from both ends or, e.g. for datagram clients of /dev/log, only from
+        // the client; count each unordered pair once
+        std::set<std::pair<uint32_t, uint32_t>> unix_pairs;
+        for (const auto& [inode, peer] : unix_peers) {
+            if (unix_pairs.emplace(std::min(inode, peer), std::max(inode, peer)).second) {
+                add_edge(owner_of(inode), owner_of(peer), "unix", 0.0f);
+            }
+        }
+
+        std::unordered_map<uint64_t, uint64_t> initial_bytes;
+        for (const auto& sock : initial_sockets) {
+            initial_bytes[sock.cookie] = sock.tcp_info.tcpi_bytes_acked + sock.tcp_info.tcpi_bytes_received;
+        }
+
+        // Pair loopback connections with the socket whose local and remote endpoints are swapped.
+        // Sockets accepted by one server share its local endpoint, so the key is the full 4-tuple.
+        // IPv4 clients of a dual-stack listener show up as ::ffff:a.b.c.d on the server end.
+        auto endpoint_key = [](uint8_t family, const std::array<uint8_t, 16>& local_raw, uint16_t local_port,
+                               const std::array<uint8_t, 16>& remote_raw, uint16_t remote_port) {
+            return format_unmapped_address(family, local_raw) + "|" + std::to_string(local_port) + "|" +
+                   format_unmapped_address(family, remote_raw) + "|" + std::to_string(remote_port);
+        };
+        std::unordered_map<std::string, const InetSocketSample*> by_endpoints;
+        for (const auto& sock : final_sockets) {
+            if (is_loopback(sock.family, sock.remote_raw)) {
+                by_endpoints[endpoint_key(sock.family, sock.local_raw, sock.local_port, sock.remote_raw, sock.remote_port)] = &sock;
+            }
+        }
+
+        float time_diff = 0.1f; // 100ms in seconds
+        for (const auto& [endpoints, sock] : by_endpoints) {
+            auto peer = by_endpoints.find(endpoint_key(sock->family, sock->remote_raw, sock->remote_port,
+                                                       sock->local_raw, sock->local_port));
+            if (peer == by_endpoints.end()) continue;
+            // Count each connection once, from the end with the lower cookie
+            if (sock->cookie > peer->second->cookie) continue;
+
+            // Acked plus received bytes on one end covers both directions
+            uint64_t total = sock->tcp_info.tcpi_bytes_acked + sock->tcp_info.tcpi_bytes_received;
+            auto previous = initial_bytes.find(sock->cookie);
+            uint64_t delta = previous != initial_bytes.end() ? total - previous->second : total;
+            add_edge(owner_of(sock->inode), owner_of(peer->second->inode), "tcp", delta / time_diff);
+        }
+
+        std::unordered_map<uint32_t, std::string> process_names;
+        auto name_of = [&process_names](uint32_t pid) {
+            auto [it, inserted] = process_names.try_emplace(pid);
+            if (inserted) it->second = get_process_name(pid);
+            return it->second;
+        };
+
+        for (auto& [key, edge] : edges) {
+            edge.process_name_a = name_of(edge.pid_a);
+            edge.process_name_b = name_of(edge.pid_b);
+            result.push_back(std::move(edge));
+        }
+
+        std::sort(result.begin(), result.end(),
+                  [](const ProcessCommunicationEdge& a, const ProcessCommunicationEdge& b) {
+                      return a.bytes_per_sec != b.bytes_per_sec ? a.bytes_per_sec > b.bytes_per_sec
+                                                                : a.connection_count > b.connection_count;
+                  });
+        return result;
+    }
+};
+
+// Implement the public interface
+NetworkDetector::NetworkDetector() : pimpl_(std::make_unique<Impl>()) {}
+NetworkDetector::~NetworkDetector() = default;
+
+std::optional<NetworkProcessInfo> NetworkDetector::get_process_info(uint32_t pid) const {
+    return pimpl_->get_process_info(pid);
+}
+
+std::optional<std::vector<NetworkProcessInfo>> NetworkDetector::get_process_info(const std::string& process_name) const {
+    return pimpl_->get_process_info(process_name);
+}
+
+std::vector<NetworkInterfaceInfo> NetworkDetector::get_interface_info() const {
+    return pimpl_->get_interface_info();
+}
+
+std::vector<std::string> NetworkDetector::get_interface_names() const {
+    return pimpl_->get_interface_names();
+}
+
+TCPHealthReport NetworkDetector::get_tcp_health() const {
+    return pimpl_->get_tcp_health();
+}
+
+ListenQueueReport NetworkDetector::get_listen_queue_info(float threshold_percent, uint32_t sustained_samples) const {
+    return pimpl_->get_listen_queue_info(threshold_percent, sustained_samples);
+}
+
+SocketBufferReport NetworkDetector::get_socket_buffer_info() const {
+    return pimpl_->get_socket_buffer_info();
+}
+
+std::vector<NICQueueInfo> NetworkDetector::get_nic_queue_info() const {
+    return pimpl_->get_nic_queue_info();
+}
+
+std::vector<SoftnetCPUStats> NetworkDetector::get_softnet_stats() const {
+    return pimpl_->get_softnet_stats();
+}
+
+std::vector<NetworkNamespaceInfo> NetworkDetector::get_namespace_info() const {
+    return pimpl_->get_namespace_info();
+}
+
+std::optional<ConntrackInfo> NetworkDetector::get_conntrack_info(float warn_percent) const {
+    return pimpl_->get_conntrack_info(warn_percent);
+}
+
+std::vector<QdiscInfo> NetworkDetector::get_qdisc_info() const {
+    return pimpl_->get_qdisc_info();
+}
+
+TCPChurnReport NetworkDetector::get_tcp_churn(uint32_t close_wait_threshold) const {
+    return pimpl_->get_tcp_churn(close_wait_threshold);
+}
+
+std::vector<TopTalkerInfo> NetworkDetector::get_top_talkers(TalkerGrouping grouping, size_t limit,
+                                                            size_t sketch_capacity) const {
+    return pimpl_->get_top_talkers(grouping, limit, sketch_capacity);
+}
+
+NetworkTrafficSummary NetworkDetector::get_traffic_summary() const {
+    return pimpl_->get_traffic_summary();
+}
+
+bool NetworkDetector::start_microburst_monitor(const std::vector<std::string>& interfaces, uint32_t sample_interval_us,
+                                               float burst_threshold_percent) {
+    return pimpl_->start_microburst_monitor(interfaces, sample_interval_us, burst_threshold_percent);
+}
+
+void NetworkDetector::stop_microburst_monitor() {
+    pimpl_->stop_microburst_monitor();
+}
+
+std::vector<MicroburstInfo> NetworkDetector::get_microburst_info() const {
+    return pimpl_->get_microburst_info();
+}
+
+std::vector<ProcessCommunicationEdge> NetworkDetector::get_process_communication_graph() const {
+    return pimpl_->get_process_communication_graph();
 }
 
 } // namespace hw_monitor 
@@ -1,5 +1,6 @@
 #include "nvidia_gpu_detector.hpp"
 #include <cstring>
+#include <cstdlib>
 #include <array>
 #include <fstream>
 #include <algorithm> // for std::transform
@@ -8,13 +9,44 @@
 #include <thread>    // for std::this_thread
 #include <chrono>    // for std::chrono
 #include <unordered_map>
+#include <unordered_set>
 #include <filesystem>
 #include <sstream>
 
 namespace hw_monitor {
 
+namespace {
+
+/**
+ * Run an NVML list query following its count protocol: the call reports the required
+ * entry count with NVML_ERROR_INSUFFICIENT_SIZE (or with a null buffer), the buffer
+ * grows and the call is retried. The buffer keeps its size for the next call.
+ */
+template<typename Entry, typename Query>
+nvmlReturn_t query_with_growing_buffer(std::vector<Entry>& buffer, unsigned int& count, Query query) {
+    nvmlReturn_t ret = NVML_ERROR_INSUFFICIENT_SIZE;
+    for (int attempt = 0; attempt < 4; attempt++) {
+        count = static_cast<unsigned int>(buffer.size());
+        ret = query(&count, buffer.empty() ? nullptr : buffer.data());
+
+        bool size_only = buffer.empty() && ret == NVML_SUCCESS && count > 0;
+        if (ret != NVML_ERROR_INSUFFICIENT_SIZE && !size_only) return ret;
+
+        // Leave headroom for entries that appear between the two calls
+        buffer.resize(std::max<size_t>(count + count / 4 + 1, buffer.size() * 2));
+    }
+    count = 0;
+    return ret == NVML_SUCCESS ? NVML_ERROR_INSUFFICIENT_SIZE : ret;
+}
+
+} // namespace
+
 NvidiaGPUDetector::NvidiaGPUDetector() : initialized_(false), nvml_handle_(nullptr) {
-    if (!check_nvidia_gpu()) {
+    // An explicitly chosen library (e.g. the mock NVML) bypasses the driver check
+    const char* library_override = std::getenv("HW_MONITOR_NVML_LIBRARY");
+    if (library_override && *library_override == '\0') library_override = nullptr;
+
+    if (!library_override && !check_nvidia_gpu()) {
         debug_print("No NVIDIA GPU found");
         return;
     }
@@ -23,12 +55,15 @@ NvidiaGPUDetector::NvidiaGPUDetector() : initialized_(false), nvml_handle_(nullp
 
     #ifdef __linux__
     // Try multiple possible library names
-    const char* lib_names[] = {
+    std::vector<const char*> lib_names = {
         "libnvidia-ml.so.1",
         "libnvidia-ml.so",
         "/usr/lib/x86_64-linux-gnu/libnvidia-ml.so.1",
         "/usr/lib/x86_64-linux-gnu/libnvidia-ml.so"
     };
+    if (library_override) {
+        lib_names = {library_override};
+    }
 
     for (const auto& lib_name : lib_names) {
         nvml_handle_ = dlopen(lib_name, RTLD_LAZY);
@@ -56,11 +91,8 @@ NvidiaGPUDetector::NvidiaGPUDetector() : initialized_(false), nvml_handle_(nullp
             initialized_ = true;
             debug_print("NVML initialized successfully");
 
-            // Print available devices
-            unsigned int device_count = 0;
-            if (nvmlDeviceGetCount_v2_ptr(&device_count) == NVML_SUCCESS) {
-                debug_print("Found " + std::to_string(device_count) + " NVIDIA devices");
-            }
+            cache_devices();
+            debug_print("Found " + std::to_string(devices_.size()) + " NVIDIA devices");
         } else {
             debug_print("Failed to initialize NVML");
         }
@@ -68,6 +100,7 @@ NvidiaGPUDetector::NvidiaGPUDetector() : initialized_(false), nvml_handle_(nullp
 }
 
 NvidiaGPUDetector::~NvidiaGPUDetector() {
+    stop_event_listener();
     if (initialized_ && nvmlShutdown_ptr) {
         nvmlShutdown_ptr();
     }
@@ -101,45 +134,148 @@ bool NvidiaGPUDetector::is_available() const {
     return initialized_;
 }
 
+void NvidiaGPUDetector::cache_devices() {
+    unsigned int device_count = 0;
+    if (nvmlDeviceGetCount_v2_ptr(&device_count) != NVML_SUCCESS) return;
+
+    for (unsigned int i = 0; i < device_count; i++) {
+        DeviceCache device{};
+        if (nvmlDeviceGetHandleByIndex_v2_ptr(i, &device.handle) != NVML_SUCCESS) continue;
+        device.index = i;
+
+        char name[NVML_DEVICE_NAME_BUFFER_SIZE];
+        if (nvmlDeviceGetName_ptr(device.handle, name, NVML_DEVICE_NAME_BUFFER_SIZE) == NVML_SUCCESS) {
+            device.name = name;
+        }
+
+        char uuid[NVML_DEVICE_UUID_V2_BUFFER_SIZE];
+        if (nvmlDeviceGetUUID_ptr && nvmlDeviceGetUUID_ptr(device.handle, uuid, NVML_DEVICE_UUID_V2_BUFFER_SIZE) == NVML_SUCCESS) {
+            device.uuid = uuid;
+        }
+
+        nvmlPciInfo_t pci_info;
+        if (nvmlDeviceGetPciInfo_v3_ptr && nvmlDeviceGetPciInfo_v3_ptr(device.handle, &pci_info) == NVML_SUCCESS) {
+            device.pci_bus_id = pci_info.busId;
+        }
+
+        nvmlMemory_t memory;
+        if (nvmlDeviceGetMemoryInfo_ptr(device.handle, &memory) == NVML_SUCCESS) {
+            device.total_memory_mb = memory.total / (1024.0 * 1024.0);
+        }
+
+        devices_.push_back(std::move(device));
+    }
+}
+
+GPUInfo NvidiaGPUDetector::build_gpu_info(const DeviceCache& device) const {
+    GPUInfo gpu_info{};
+    gpu_info.index = device.index;
+    gpu_info.name = device.name;
+    gpu_info.uuid = device.uuid;
+    gpu_info.pci_bus_id = device.pci_bus_id;
+    gpu_info.total_memory_mb = device.total_memory_mb;
+
+    nvmlMemory_t memory;
+    if (nvmlDeviceGetMemoryInfo_ptr(device.handle, &memory) == NVML_SUCCESS) {
+        gpu_info.used_memory_mb = memory.used / (1024.0 * 1024.0);
+    }
+
+    unsigned int temperature;
+    if (nvmlDeviceGetTemperature_ptr(device.handle, NVML_TEMPERATURE_GPU, &temperature) == NVML_SUCCESS) {
+        gpu_info.temperature_celsius = temperature;
+    }
+
+    nvmlUtilization_t utilization;
+    if (nvmlDeviceGetUtilizationRates_ptr(device.handle, &utilization) == NVML_SUCCESS) {
+        gpu_info.utilization_percent = utilization.gpu;
+    }
+
+    read_extended_telemetry(device, gpu_info);
+
+    // Get process information
+    gpu_info.processes = get_process_info_for_device(device);
+    for (auto& proc : gpu_info.processes) {
+        proc.gpu_index = device.index;
+    }
+
+    return gpu_info;
+}
+
+void NvidiaGPUDetector::read_extended_telemetry(const DeviceCache& device, GPUInfo& gpu_info) const {
+    std::lock_guard<std::mutex> lock(query_mutex_);
+
+    // Run a query unless it is known to be unsupported; remember NOT_SUPPORTED answers
+    auto query = [&device](TelemetryField field, bool loaded, auto&& call) {
+        if (!loaded || (device.unsupported_telemetry & field)) return false;
+        nvmlReturn_t ret = call();
+        if (ret == NVML_ERROR_NOT_SUPPORTED || ret == NVML_ERROR_FUNCTION_NOT_FOUND) {
+            device.unsupported_telemetry |= field;
+        }
+        return ret == NVML_SUCCESS;
+    };
+
+    unsigned int value;
+    if (query(TELEMETRY_POWER_DRAW, nvmlDeviceGetPowerUsage_ptr, [&] { return nvmlDeviceGetPowerUsage_ptr(device.handle, &value); })) {
+        gpu_info.power_draw_watts = value / 1000.0f;
+    }
+    if (query(TELEMETRY_POWER_LIMIT, nvmlDeviceGetEnforcedPowerLimit_ptr, [&] { return nvmlDeviceGetEnforcedPowerLimit_ptr(device.handle, &value); })) {
+        gpu_info.power_limit_watts = value / 1000.0f;
+    }
+    if (query(TELEMETRY_SM_CLOCK, nvmlDeviceGetClockInfo_ptr, [&] { return nvmlDeviceGetClockInfo_ptr(device.handle, NVML_CLOCK_SM, &value); })) {
+        gpu_info.sm_clock_mhz = value;
+    }
+    if (query(TELEMETRY_MEMORY_CLOCK, nvmlDeviceGetClockInfo_ptr, [&] { return nvmlDeviceGetClockInfo_ptr(device.handle, NVML_CLOCK_MEM, &value); })) {
+        gpu_info.memory_clock_mhz = value;
+    }
+    if (query(TELEMETRY_GRAPHICS_CLOCK, nvmlDeviceGetClockInfo_ptr, [&] { return nvmlDeviceGetClockInfo_ptr(device.handle, NVML_CLOCK_GRAPHICS, &value); })) {
+        gpu_info.graphics_clock_mhz = value;
+    }
+    if (query(TELEMETRY_PCIE_TX, nvmlDeviceGetPcieThroughput_ptr, [&] { return nvmlDeviceGetPcieThroughput_ptr(device.handle, NVML_PCIE_UTIL_TX_BYTES, &value); })) {
+        gpu_info.pcie_tx_kbps = value;
+    }
+    if (query(TELEMETRY_PCIE_RX, nvmlDeviceGetPcieThroughput_ptr, [&] { return nvmlDeviceGetPcieThroughput_ptr(device.handle, NVML_PCIE_UTIL_RX_BYTES, &value); })) {
+        gpu_info.pcie_rx_kbps = value;
+    }
+
+    unsigned int sampling_period_us;
+    if (query(TELEMETRY_ENCODER, nvmlDeviceGetEncoderUtilization_ptr, [&] { return nvmlDeviceGetEncoderUtilization_ptr(device.handle, &value, &sampling_period_us); })) {
+        gpu_info.encoder_utilization_percent = value;
+    }
+    if (query(TELEMETRY_DECODER, nvmlDeviceGetDecoderUtilization_ptr, [&] { return nvmlDeviceGetDecoderUtilization_ptr(device.handle, &value, &sampling_period_us); })) {
+        gpu_info.decoder_utilization_percent = value;
+    }
+    if (query(TELEMETRY_FAN_SPEED, nvmlDeviceGetFanSpeed_ptr, [&] { return nvmlDeviceGetFanSpeed_ptr(device.handle, &value); })) {
+        gpu_info.fan_speed_percent = value;
+    }
+
+    nvmlPstates_t pstate;
+    if (query(TELEMETRY_PERFORMANCE_STATE, nvmlDeviceGetPerformanceState_ptr, [&] { return nvmlDeviceGetPerformanceState_ptr(device.handle, &pstate); }) &&
+        pstate != NVML_PSTATE_UNKNOWN) {
+        gpu_info.performance_state = pstate;
+    }
+
+    unsigned long long counter;
+    if (query(TELEMETRY_THROTTLE_REASONS, nvmlDeviceGetCurrentClocksThrottleReasons_ptr, [&] { return nvmlDeviceGetCurrentClocksThrottleReasons_ptr(device.handle, &counter); })) {
+        gpu_info.throttle_reasons = counter;
+    }
+    if (query(TELEMETRY_ECC_CORRECTED, nvmlDeviceGetTotalEccErrors_ptr, [&] { return nvmlDeviceGetTotalEccErrors_ptr(device.handle, NVML_MEMORY_ERROR_TYPE_CORRECTED, NVML_VOLATILE_ECC, &counter); })) {
+        gpu_info.ecc_corrected_errors = counter;
+    }
+    if (query(TELEMETRY_ECC_UNCORRECTED, nvmlDeviceGetTotalEccErrors_ptr, [&] { return nvmlDeviceGetTotalEccErrors_ptr(device.handle, NVML_MEMORY_ERROR_TYPE_UNCORRECTED, NVML_VOLATILE_ECC, &counter); })) {
+        gpu_info.ecc_uncorrected_errors = counter;
+    }
+}
+
 std::vector<GPUInfo> NvidiaGPUDetector::get_gpu_info() const {
     std::vector<GPUInfo> result;
     if (!initialized_) return result;
 
-    unsigned int device_count = 0;
-    if (nvmlDeviceGetCount_v2_ptr(&device_count) == NVML_SUCCESS) {
-        for (unsigned int i = 0; i < device_count; i++) {
-            nvmlDevice_t device;
-            if (nvmlDeviceGetHandleByIndex_v2_ptr(i, &device) == NVML_SUCCESS) {
-                GPUInfo gpu_info;
-                
-                char name[NVML_DEVICE_NAME_BUFFER_SIZE];
-                if (nvmlDeviceGetName_ptr(device, name, NVML_DEVICE_NAME_BUFFER_SIZE) == NVML_SUCCESS) {
-                    gpu_info.name = name;
-                }
-                gpu_info.index = i;
-                
-                nvmlMemory_t memory;
-                if (nvmlDeviceGetMemoryInfo_ptr(device, &memory) == NVML_SUCCESS) {
-                    gpu_info.total_memory_mb = memory.total / (1024.0 * 1024.0);
-                    gpu_info.used_memory_mb = memory.used / (1024.0 * 1024.0);
-                }
-                
-                unsigned int temperature;
-                if (nvmlDeviceGetTemperature_ptr(device, NVML_TEMPERATURE_GPU, &temperature) == NVML_SUCCESS) {
-                    gpu_info.temperature_celsius = temperature;
-                }
-                
-                nvmlUtilization_t utilization;
-                if (nvmlDeviceGetUtilizationRates_ptr(device, &utilization) == NVML_SUCCESS) {
-                    gpu_info.utilization_percent = utilization.gpu;
-                }
-                
-                // Get process information
-                gpu_info.processes = get_process_info_for_device(device);
-                
-                result.push_back(std::move(gpu_info));
-            }
-        }
+    std::vector<const DeviceCache*> devices;
+    for (const auto& device : devices_) devices.push_back(&device);
+    warm_up_process_utilization(devices);
+
+    for (const auto& device : devices_) {
+        result.push_back(build_gpu_info(device));
     }
     return result;
 }
@@ -177,98 +313,37 @@ std::optional<std::vector<GPUProcessInfo>> NvidiaGPUDetector::get_process_info(c
 
     debug_print("Searching for process: " + process_name);
 
-    unsigned int device_count = 0;
-    if (nvmlDeviceGetCount_v2_ptr(&device_count) == NVML_SUCCESS) {
-        for (unsigned int i = 0; i < device_count; i++) {
-            nvmlDevice_t device;
-            if (nvmlDeviceGetHandleByIndex_v2_ptr(i, &device) == NVML_SUCCESS) {
-                // Get compute processes
-                std::array<nvmlProcessInfo_t, 128> compute_processes;
-                unsigned int compute_count = compute_processes.size();
-                
-                if (nvmlDeviceGetComputeRunningProcesses_ptr(device, &compute_count, compute_processes.data()) == NVML_SUCCESS) {
-                    debug_print("Found " + std::to_string(compute_count) + " compute processes on GPU " + std::to_string(i));
-                    for (unsigned int p = 0; p < compute_count; p++) {
-                        std::string current_name = get_process_name(compute_processes[p].pid);
-                        if (current_name.find(process_name) != std::string::npos) {
-                            GPUProcessInfo proc_info;
-                            proc_info.pid = compute_processes[p].pid;
-                            proc_info.process_name = current_name;
-                            proc_info.memory_usage_mb = compute_processes[p].usedGpuMemory / (1024.0 * 1024.0);
-                            proc_info.gpu_index = i;
-                            result.push_back(std::move(proc_info));
-                        }
-                    }
-                }
-
-                // Get graphics processes
-                std::array<nvmlProcessInfo_t, 128> graphics_processes;
-                unsigned int graphics_count = graphics_processes.size();
-                
-                if (nvmlDeviceGetGraphicsRunningProcesses_ptr(device, &graphics_count, graphics_processes.data()) == NVML_SUCCESS) {
-                    debug_print("Found " + std::to_string(graphics_count) + " graphics processes on GPU " + std::to_string(i));
-                    for (unsigned int p = 0; p < graphics_count; p++) {
-                        std::string current_name = get_process_name(graphics_processes[p].pid);
-                        debug_print("Graphics process: " + current_name + " (PID: " + std::to_string(graphics_processes[p].pid) + ")");
-                        
-                        // Check if we already have this process from compute processes
-                        bool already_added = false;
-                        for (const auto& existing : result) {
-                            if (existing.pid == graphics_processes[p].pid) {
-                                already_added = true;
-                                break;
-                            }
-                        }
-
-                        if (!already_added && current_name.find(process_name) != std::string::npos) {
-                            GPUProcessInfo proc_info;
-                            proc_info.pid = graphics_processes[p].pid;
-                            proc_info.process_name = current_name;
-                            proc_info.memory_usage_mb = graphics_processes[p].usedGpuMemory / (1024.0 * 1024.0);
-                            proc_info.gpu_index = i;
-                            result.push_back(std::move(proc_info));
-                        }
-                    }
+    std::vector<const DeviceCache*> devices;
+    for (const auto& device : devices_) devices.push_back(&device);
+    warm_up_process_utilization(devices);
+
+    for (const auto& device : devices_) {
+        size_t device_first = result.size();
+
+        // Get compute and graphics processes, skipping processes that are both
+        std::unordered_set<unsigned int> seen;
+        for (bool graphics : {false, true}) {
+            for_each_running_process(device, graphics, [&](unsigned int pid, unsigned long long used_memory) {
+                if (!seen.insert(pid).second) return;
+
+                std::string current_name = get_process_name(pid);
+                if (current_name.find(process_name) != std::string::npos) {
+                    GPUProcessInfo proc_info{};
+                    proc_info.pid = pid;
+                    proc_info.process_name = current_name;
+                    proc_info.memory_usage_mb = used_memory / (1024.0 * 1024.0);
+                    proc_info.gpu_index = device.index;
+                    result.push_back(std::move(proc_info));
                 }
+            });
+        }
 
-                // Get utilization for all found processes
-                if (!result.empty() && nvmlDeviceGetProcessUtilization_ptr) {
-                    std::array<nvmlProcessUtilizationSample_t, 128> samples;
-                    unsigned int sample_count = samples.size();
-                    unsigned long long lastSeenTimeStamp = 0;
-
-                    nvmlReturn_t ret = nvmlDeviceGetProcessUtilization_ptr(device, samples.data(), &sample_count, lastSeenTimeStamp);
-                    debug_print("Initial utilization query return code: " + std::to_string(ret));
-                    if (ret == NVML_ERROR_NOT_SUPPORTED) {
-                        debug_print("Process utilization query not supported on this GPU/driver");
-                    } else if (ret == NVML_ERROR_INSUFFICIENT_PERMISSIONS) {
-                        debug_print("Insufficient permissions to query process utilization");
-                    }
-
-                    if (ret == NVML_SUCCESS) {
-                        debug_print("Got utilization data for " + std::to_string(sample_count) + " processes");
-                        std::unordered_map<unsigned int, float> pidToUtil;
-                        for (unsigned int s = 0; s < sample_count; s++) {
-                            pidToUtil[samples[s].pid] = samples[s].smUtil;
-                            debug_print("Process " + std::to_string(samples[s].pid) + 
-                                       " utilization: " + std::to_string(samples[s].smUtil));
-                        }
-
-                        debug_print("Total processes with utilization data: " + std::to_string(pidToUtil.size()));
-                        for (const auto& [pid, util] : pidToUtil) {
-                            debug_print("PID " + std::to_string(pid) + " has utilization " + std::to_string(util));
-                        }
-
-                        for (auto& proc_info : result) {
-                            for (unsigned int s = 0; s < sample_count; s++) {
-                                if (samples[s].pid == proc_info.pid) {
-                                    proc_info.gpu_usage_percent = samples[s].smUtil;
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                }
+        // Get utilization for the processes found on this device
+        if (result.size() > device_first && nvmlDeviceGetProcessUtilization_ptr) {
+            auto pidToUtil = read_process_utilization(device);
+            for (size_t r = device_first; r < result.size(); r++) {
+                auto it = pidToUtil.find(result[r].pid);
+                result[r].gpu_usage_percent = it != pidToUtil.end() ? it->second : 0.0f;
             }
         }
     }
@@ -292,15 +367,261 @@ std::optional<std::vector<GPUProcessInfo>> NvidiaGPUDetector::get_process_info(u
 }
 
 std::optional<GPUInfo> NvidiaGPUDetector::get_gpu_info(uint32_t gpu_index) const {
-    auto all_gpus = get_gpu_info();
-    for (const auto& gpu : all_gpus) {
-        if (gpu.index == gpu_index) {
-            return gpu;
+    if (!initialized_) return std::nullopt;
+
+    for (const auto& device : devices_) {
+        if (device.index == gpu_index) {
+            warm_up_process_utilization({&device});
+            return build_gpu_info(device);
         }
     }
     return std::nullopt;
 }
 
+std::vector<GPUSampleStats> NvidiaGPUDetector::get_sample_stats() const {
+    std::vector<GPUSampleStats> result;
+    if (!initialized_ || !nvmlDeviceGetSamples_ptr) return result;
+
+    static constexpr std::array<std::pair<nvmlSamplingType_t, GPUSampleType>, NVML_SAMPLINGTYPE_COUNT> sample_types = {{
+        {NVML_TOTAL_POWER_SAMPLES, GPUSampleType::PowerWatts},
+        {NVML_GPU_UTILIZATION_SAMPLES, GPUSampleType::GPUUtilization},
+        {NVML_MEMORY_UTILIZATION_SAMPLES, GPUSampleType::MemoryUtilization},
+        {NVML_ENC_UTILIZATION_SAMPLES, GPUSampleType::EncoderUtilization},
+        {NVML_DEC_UTILIZATION_SAMPLES, GPUSampleType::DecoderUtilization},
+        {NVML_PROCESSOR_CLK_SAMPLES, GPUSampleType::ProcessorClockMHz},
+        {NVML_MEMORY_CLK_SAMPLES, GPUSampleType::MemoryClockMHz}
+    }};
+
+    std::lock_guard<std::mutex> lock(query_mutex_);
+
+    std::vector<double> values;
+    for (const auto& device : devices_) {
+        for (const auto& [sampling_type, type] : sample_types) {
+            uint32_t bit = 1u << sampling_type;
+            if (device.unsupported_history & bit) continue;
+
+            unsigned long long& last_seen = device.history_last_seen[sampling_type];
+            nvmlValueType_t value_type = NVML_VALUE_TYPE_UNSIGNED_INT;
+            unsigned int count = 0;
+            nvmlReturn_t ret = query_with_growing_buffer(history_buffer_, count, [&](unsigned int* n, nvmlSample_t* data) {
+                return nvmlDeviceGetSamples_ptr(device.handle, sampling_type, last_seen, &value_type, n, data);
+            });
+            if (ret == NVML_ERROR_NOT_SUPPORTED) {
+                device.unsupported_history |= bit;
+                continue;
+            }
+            // NVML_ERROR_NOT_FOUND: no samples since the previous poll
+            if (ret != NVML_SUCCESS || count == 0) continue;
+
+            GPUSampleStats stats{};
+            stats.gpu_index = device.index;
+            stats.type = type;
+            stats.first_timestamp_us = history_buffer_[0].timeStamp;
+
+            values.clear();
+            for (unsigned int i = 0; i < count; i++) {
+                const nvmlValue_t& sample = history_buffer_[i].sampleValue;
+                double value;
+                switch (value_type) {
+                    case NVML_VALUE_TYPE_DOUBLE: value = sample.dVal; break;
+                    case NVML_VALUE_TYPE_UNSIGNED_LONG: value = sample.ulVal; break;
+                    case NVML_VALUE_TYPE_UNSIGNED_LONG_LONG: value = sample.ullVal; break;
+                    case NVML_VALUE_TYPE_SIGNED_LONG_LONG: value = sample.sllVal; break;
+                    default: value = sample.uiVal; break;
+                }
+                // Power samples are reported in milliwatts
+                values.push_back(sampling_type == NVML_TOTAL_POWER_SAMPLES ? value / 1000.0 : value);
+
+                stats.first_timestamp_us = std::min<uint64_t>(stats.first_timestamp_us, history_buffer_[i].timeStamp);
+                stats.last_timestamp_us = std::max<uint64_t>(stats.last_timestamp_us, history_buffer_[i].timeStamp);
+            }
+            last_seen = std::max<unsigned long long>(last_seen, stats.last_timestamp_us);
+
+            std::sort(values.begin(), values.end());
+            auto percentile = [&values](double p) {
+                size_t rank = static_cast<size_t>(p / 100.0 * (values.size() - 1) + 0.5);
+                return values[std::min(rank, values.size() - 1)];
+            };
+
+            stats.sample_count = count;
+            stats.min = values.front();
+            stats.max = values.back();
+            double sum = 0;
+            for (double value : values) sum += value;
+            stats.mean = sum / values.size();
+            stats.p50 = percentile(50);
+            stats.p90 = percentile(90);
+            stats.p99 = percentile(99);
+            result.push_back(stats);
+        }
+    }
+
+    return result;
+}
+
+std::vector<GPUAccountingInfo> NvidiaGPUDetector::get_accounting_info() const {
+    std::vector<GPUAccountingInfo> result;
+    if (!initialized_ || !nvmlDeviceGetAccountingPids_ptr || !nvmlDeviceGetAccountingStats_ptr) return result;
+
+    std::lock_guard<std::mutex> lock(query_mutex_);
+
+    for (const auto& device : devices_) {
+        nvmlEnableState_t mode;
+        if (nvmlDeviceGetAccountingMode_ptr &&
+            (nvmlDeviceGetAccountingMode_ptr(device.handle, &mode) != NVML_SUCCESS || mode != NVML_FEATURE_ENABLED)) {
+            continue;
+        }
+
+        unsigned int count = 0;
+        nvmlReturn_t ret = query_with_growing_buffer(accounting_pid_buffer_, count, [&](unsigned int* n, unsigned int* pids) {
+            return nvmlDeviceGetAccountingPids_ptr(device.handle, n, pids);
+        });
+        if (ret != NVML_SUCCESS) {
+            debug_print("Failed to get accounting PIDs on GPU " + std::to_string(device.index) + ": " + std::to_string(ret));
+            continue;
+        }
+
+        // Forget reported PIDs that dropped out of the driver's circular buffer
+        std::unordered_set<unsigned int> listed(accounting_pid_buffer_.begin(), accounting_pid_buffer_.begin() + count);
+        for (auto it = device.finalized_pids.begin(); it != device.finalized_pids.end();) {
+            it = listed.count(*it) ? std::next(it) : device.finalized_pids.erase(it);
+        }
+        for (auto it = device.running_names.begin(); it != device.running_names.end();) {
+            it = listed.count(it->first) ? std::next(it) : device.running_names.erase(it);
+        }
+
+        for (unsigned int i = 0; i < count; i++) {
+            unsigned int pid = accounting_pid_buffer_[i];
+            if (device.finalized_pids.count(pid)) continue;
+
+            nvmlAccountingStats_t stats;
+            if (nvmlDeviceGetAccountingStats_ptr(device.handle, pid, &stats) != NVML_SUCCESS) continue;
+
+            GPUAccountingInfo info{};
+            info.pid = pid;
+            info.gpu_index = device.index;
+            info.gpu_utilization_percent = stats.gpuUtilization;
+            info.memory_utilization_percent = stats.memoryUtilization;
+            info.max_memory_usage_mb = stats.maxMemoryUsage / (1024.0 * 1024.0);
+            info.run_time_ms = stats.time;
+            info.start_time_us = stats.startTime;
+            info.is_running = stats.isRunning != 0;
+
+            if (info.is_running) {
+                auto [name, inserted] = device.running_names.try_emplace(pid);
+                if (inserted) name->second = get_process_name(pid);
+                info.process_name = name->second;
+            } else {
+                auto name = device.running_names.find(pid);
+                if (name != device.running_names.end()) {
+                    info.process_name = std::move(name->second);
+                    device.running_names.erase(name);
+                }
+                device.finalized_pids.insert(pid);
+            }
+
+            result.push_back(std::move(info));
+        }
+    }
+
+    return result;
+}
+
+bool NvidiaGPUDetector::start_event_listener(GPUEventCallback callback) {
+    if (!initialized_ || !callback) return false;
+    if (!nvmlEventSetCreate_ptr || !nvmlEventSetFree_ptr || !nvmlDeviceRegisterEvents_ptr || !nvmlEventSetWait_v2_ptr) {
+        debug_print("NVML event API not available");
+        return false;
+    }
+
+    stop_event_listener();
+
+    if (nvmlEventSetCreate_ptr(&event_set_) != NVML_SUCCESS) {
+        debug_print("Failed to create NVML event set");
+        event_set_ = nullptr;
+        return false;
+    }
+
+    const unsigned long long wanted = nvmlEventTypeXidCriticalError | nvmlEventTypeDoubleBitEccError |
+                                      nvmlEventTypeSingleBitEccError | nvmlEventTypePState | nvmlEventTypeClock;
+    size_t registered = 0;
+    for (const auto& device : devices_) {
+        unsigned long long types = wanted;
+        unsigned long long supported = 0;
+        if (nvmlDeviceGetSupportedEventTypes_ptr &&
+            nvmlDeviceGetSupportedEventTypes_ptr(device.handle, &supported) == NVML_SUCCESS) {
+            types &= supported;
+        }
+        if (types == 0) continue;
+
+        nvmlReturn_t ret = nvmlDeviceRegisterEvents_ptr(device.handle, types, event_set_);
+        if (ret == NVML_SUCCESS) {
+            registered++;
+        } else {
+            debug_print("Failed to register events on GPU " + std::to_string(device.index) + ": " + std::to_string(ret));
+        }
+    }
+
+    if (registered == 0) {
+        nvmlEventSetFree_ptr(event_set_);
+        event_set_ = nullptr;
+        return false;
+    }
+
+    event_running_ = true;
+    event_thread_ = std::thread(&NvidiaGPUDetector::event_loop, this, std::move(callback));
+    return true;
+}
+
+void NvidiaGPUDetector::stop_event_listener() {
+    event_running_ = false;
+    if (event_thread_.joinable()) {
+        event_thread_.join();
+    }
+    if (event_set_) {
+        nvmlEventSetFree_ptr(event_set_);
+        event_set_ = nullptr;
+    }
+}
+
+void NvidiaGPUDetector::event_loop(GPUEventCallback callback) {
+    // Bounded waits so stop_event_listener() is honoured promptly
+    const unsigned int wait_timeout_ms = 200;
+
+    while (event_running_) {
+        nvmlEventData_t data{};
+        nvmlReturn_t ret = nvmlEventSetWait_v2_ptr(event_set_, &data, wait_timeout_ms);
+        if (ret == NVML_ERROR_TIMEOUT) continue;
+        if (ret != NVML_SUCCESS) {
+            debug_print("Event wait failed: " + std::to_string(ret));
+            std::this_thread::sleep_for(std::chrono::milliseconds(wait_timeout_ms));
+            continue;
+        }
+
+        GPUEvent event{};
+        event.data = data.eventData;
+        event.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        for (const auto& device : devices_) {
+            if (device.handle == data.device) {
+                event.gpu_index = device.index;
+                break;
+            }
+        }
+
+        switch (data.eventType) {
+            case nvmlEventTypeXidCriticalError: event.type = GPUEventType::XidCriticalError; break;
+            case nvmlEventTypeDoubleBitEccError: event.type = GPUEventType::DoubleBitEccError; break;
+            case nvmlEventTypeSingleBitEccError: event.type = GPUEventType::SingleBitEccError; break;
+            case nvmlEventTypePState: event.type = GPUEventType::PerformanceStateChange; break;
+            case nvmlEventTypeClock: event.type = GPUEventType::ClockChange; break;
+            default: continue;
+        }
+
+        callback(event);
+    }
+}
+
 bool NvidiaGPUDetector::load_functions() {
     #ifdef __linux__
     #define LOAD_FUNC(name) name##_ptr = reinterpret_cast<decltype(name##_ptr)>(dlsym(nvml_handle_, #name))
@@ -313,137 +634,193 @@ bool NvidiaGPUDetector::load_functions() {
     LOAD_FUNC(nvmlDeviceGetCount_v2);
     LOAD_FUNC(nvmlDeviceGetHandleByIndex_v2);
     LOAD_FUNC(nvmlDeviceGetName);
+    LOAD_FUNC(nvmlDeviceGetUUID);
+    LOAD_FUNC(nvmlDeviceGetPciInfo_v3);
     LOAD_FUNC(nvmlDeviceGetMemoryInfo);
     LOAD_FUNC(nvmlDeviceGetTemperature);
     LOAD_FUNC(nvmlDeviceGetUtilizationRates);
+    LOAD_FUNC(nvmlDeviceGetComputeRunningProcesses_v3);
+    LOAD_FUNC(nvmlDeviceGetGraphicsRunningProcesses_v3);
+    LOAD_FUNC(nvmlDeviceGetComputeRunningProcesses_v2);
+    LOAD_FUNC(nvmlDeviceGetGraphicsRunningProcesses_v2);
     LOAD_FUNC(nvmlDeviceGetComputeRunningProcesses);
     LOAD_FUNC(nvmlDeviceGetGraphicsRunningProcesses);
     LOAD_FUNC(nvmlDeviceGetProcessUtilization);
+    LOAD_FUNC(nvmlDeviceGetPowerUsage);
+    LOAD_FUNC(nvmlDeviceGetEnforcedPowerLimit);
+    LOAD_FUNC(nvmlDeviceGetClockInfo);
+    LOAD_FUNC(nvmlDeviceGetPcieThroughput);
+    LOAD_FUNC(nvmlDeviceGetEncoderUtilization);
+    LOAD_FUNC(nvmlDeviceGetDecoderUtilization);
+    LOAD_FUNC(nvmlDeviceGetFanSpeed);
+    LOAD_FUNC(nvmlDeviceGetPerformanceState);
+    LOAD_FUNC(nvmlDeviceGetCurrentClocksThrottleReasons);
+    LOAD_FUNC(nvmlDeviceGetTotalEccErrors);
+    LOAD_FUNC(nvmlDeviceGetSamples);
+    LOAD_FUNC(nvmlDeviceGetAccountingMode);
+    LOAD_FUNC(nvmlDeviceGetAccountingPids);
+    LOAD_FUNC(nvmlDeviceGetAccountingStats);
+    LOAD_FUNC(nvmlEventSetCreate);
+    LOAD_FUNC(nvmlEventSetFree);
+    LOAD_FUNC(nvmlDeviceGetSupportedEventTypes);
+    LOAD_FUNC(nvmlDeviceRegisterEvents);
+    LOAD_FUNC(nvmlEventSetWait_v2);
 
     #undef LOAD_FUNC
 
-    return nvmlInit_v2_ptr && nvmlInit_v2_ptr() == NVML_SUCCESS;
+    return nvmlInit_v2_ptr && nvmlShutdown_ptr && nvmlDeviceGetCount_v2_ptr &&
+           nvmlDeviceGetHandleByIndex_v2_ptr && nvmlDeviceGetName_ptr && nvmlDeviceGetMemoryInfo_ptr &&
+           nvmlDeviceGetTemperature_ptr && nvmlDeviceGetUtilizationRates_ptr &&
+           (nvmlDeviceGetComputeRunningProcesses_v3_ptr || nvmlDeviceGetComputeRunningProcesses_v2_ptr ||
+            nvmlDeviceGetComputeRunningProcesses_ptr);
 }
 
-std::vector<GPUProcessInfo> NvidiaGPUDetector::get_process_info_for_device(nvmlDevice_t device) const {
-    std::vector<GPUProcessInfo> result;
-    
-    // Get initial utilization samples with a larger sample buffer
-    unsigned int sampleCount = 32;  // Increase buffer size
-    std::vector<nvmlProcessUtilizationSample_t> samples(sampleCount);
-    uint64_t lastSeenTimeStamp = 0;
-    
-    // Get first sample
-    nvmlReturn_t ret = nvmlDeviceGetProcessUtilization_ptr(device, samples.data(), &sampleCount, lastSeenTimeStamp);
-    if (ret != NVML_SUCCESS) {
-        debug_print("Failed to get initial process utilization: " + std::to_string(ret));
-    } else {
-        debug_print("Got initial samples: " + std::to_string(sampleCount));
-    }
+void NvidiaGPUDetector::warm_up_process_utilization(const std::vector<const DeviceCache*>& devices) const {
+    if (!nvmlDeviceGetProcessUtilization_ptr) return;
+
+    bool primed = false;
+    {
+        std::lock_guard<std::mutex> lock(query_mutex_);
+        for (const auto* device : devices) {
+            if (device->last_seen_timestamp != 0) continue;
 
-    // Store the timestamp from first sample
-    if (sampleCount > 0) {
-        lastSeenTimeStamp = samples[0].timeStamp;
+            // Start from "now" so the next poll only sees fresh samples
+            device->last_seen_timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            primed = true;
+        }
     }
 
-    // Wait a short time
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // One wait covers every device primed above
+    if (primed) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+}
 
-    // Get second sample
-    unsigned int newSampleCount = 32;
-    std::vector<nvmlProcessUtilizationSample_t> newSamples(newSampleCount);
-    ret = nvmlDeviceGetProcessUtilization_ptr(device, newSamples.data(), &newSampleCount, lastSeenTimeStamp);
+std::unordered_map<unsigned int, float> NvidiaGPUDetector::read_process_utilization(const DeviceCache& device) const {
+    std::unordered_map<unsigned int, float> pidToUtil;
+    if (!nvmlDeviceGetProcessUtilization_ptr) return pidToUtil;
+
+    std::lock_guard<std::mutex> lock(query_mutex_);
+
+    unsigned int sampleCount = 0;
+    auto& samples = sample_buffer_;
+    nvmlReturn_t ret = query_with_growing_buffer(samples, sampleCount,
+        [&](unsigned int* count, nvmlProcessUtilizationSample_t* data) {
+            return nvmlDeviceGetProcessUtilization_ptr(device.handle, data, count, device.last_seen_timestamp);
+        });
+    if (ret == NVML_ERROR_NOT_FOUND) {
+        // No samples since the previous poll
+        return pidToUtil;
+    }
     if (ret != NVML_SUCCESS) {
-        debug_print("Failed to get final process utilization: " + std::to_string(ret));
+        debug_print("Failed to get process utilization: " + std::to_string(ret));
+        return pidToUtil;
+    }
+    debug_print("Got samples: " + std::to_string(sampleCount));
+
+    // A long poll interval spans several samples per process; average them
+    std::unordered_map<unsigned int, unsigned int> pidToSamples;
+    for (unsigned int i = 0; i < sampleCount; i++) {
+        pidToUtil[samples[i].pid] += samples[i].smUtil;
+        pidToSamples[samples[i].pid]++;
+        device.last_seen_timestamp = std::max(device.last_seen_timestamp, samples[i].timeStamp);
+        debug_print("Process " + std::to_string(samples[i].pid) + 
+                   " utilization: " + std::to_string(samples[i].smUtil));
+    }
+    for (auto& [pid, util] : pidToUtil) {
+        util /= pidToSamples[pid];
+    }
+
+    return pidToUtil;
+}
+
+bool NvidiaGPUDetector::for_each_running_process(const DeviceCache& device, bool graphics,
+                                                 const std::function<void(unsigned int, unsigned long long)>& visitor) const {
+    const char* kind = graphics ? "graphics" : "compute";
+    auto query_v3 = graphics ? nvmlDeviceGetGraphicsRunningProcesses_v3_ptr : nvmlDeviceGetComputeRunningProcesses_v3_ptr;
+    auto query_v2 = graphics ? nvmlDeviceGetGraphicsRunningProcesses_v2_ptr : nvmlDeviceGetComputeRunningProcesses_v2_ptr;
+    auto query_v1 = graphics ? nvmlDeviceGetGraphicsRunningProcesses_ptr : nvmlDeviceGetComputeRunningProcesses_ptr;
+
+    std::lock_guard<std::mutex> lock(query_mutex_);
+
+    unsigned int count = 0;
+    nvmlReturn_t ret;
+    if (query_v3 || query_v2) {
+        auto query = query_v3 ? query_v3 : query_v2;
+        ret = query_with_growing_buffer(process_buffer_, count, [&](unsigned int* n, nvmlProcessInfo_t* data) {
+            return query(device.handle, n, data);
+        });
+        if (ret == NVML_SUCCESS) {
+            for (unsigned int p = 0; p < count; p++) {
+                visitor(process_buffer_[p].pid, process_buffer_[p].usedGpuMemory);
+            }
+        }
+    } else if (query_v1) {
+        ret = query_with_growing_buffer(process_buffer_v1_, count, [&](unsigned int* n, nvmlProcessInfo_v1_t* data) {
+            return query_v1(device.handle, n, data);
+        });
+        if (ret == NVML_SUCCESS) {
+            for (unsigned int p = 0; p < count; p++) {
+                visitor(process_buffer_v1_[p].pid, process_buffer_v1_[p].usedGpuMemory);
+            }
+        }
     } else {
-        debug_print("Got final samples: " + std::to_string(newSampleCount));
+        return false;
     }
 
-    // Create a map of PID to utilization
-    std::unordered_map<unsigned int, float> pidToUtil;
-    for (unsigned int i = 0; i < newSampleCount; i++) {
-        pidToUtil[newSamples[i].pid] = newSamples[i].smUtil;
-        debug_print("Process " + std::to_string(newSamples[i].pid) + 
-                   " utilization: " + std::to_string(newSamples[i].smUtil));
+    if (ret != NVML_SUCCESS) {
+        debug_print("Failed to get " + std::string(kind) + " processes on GPU " + std::to_string(device.index) +
+                    ": " + std::to_string(ret));
+        return false;
     }
+    debug_print("Found " + std::to_string(count) + " " + kind + " processes on GPU " + std::to_string(device.index));
+    return true;
+}
+
+std::vector<GPUProcessInfo> NvidiaGPUDetector::get_process_info_for_device(const DeviceCache& device) const {
+    std::vector<GPUProcessInfo> result;
+
+    // Create a map of PID to utilization
+    auto pidToUtil = read_process_utilization(device);
+
+    // Get compute and graphics processes, skipping processes that are both
+    std::unordered_set<unsigned int> seen;
+    for (bool graphics : {false, true}) {
+        for_each_running_process(device, graphics, [&](unsigned int pid, unsigned long long used_memory) {
+            if (!seen.insert(pid).second) return;
+
+            GPUProcessInfo proc_info{};
+            proc_info.pid = pid;
+            proc_info.process_name = get_process_name(pid);
+            proc_info.memory_usage_mb = used_memory / (1024.0 * 1024.0);
 
-    // Get compute processes
-    std::array<nvmlProcessInfo_t, 128> compute_processes;
-    unsigned int compute_count = compute_processes.size();
-    
-    if (nvmlDeviceGetComputeRunningProcesses_ptr(device, &compute_count, compute_processes.data()) == NVML_SUCCESS) {
-        debug_print("Found " + std::to_string(compute_count) + " compute processes");
-        for (unsigned int p = 0; p < compute_count; p++) {
-            GPUProcessInfo proc_info;
-            proc_info.pid = compute_processes[p].pid;
-            proc_info.process_name = get_process_name(proc_info.pid);
-            proc_info.memory_usage_mb = compute_processes[p].usedGpuMemory / (1024.0 * 1024.0);
-            
             // Get GPU utilization from our map
-            proc_info.gpu_usage_percent = pidToUtil.count(proc_info.pid) ? 
-                                        pidToUtil[proc_info.pid] : 0.0f;
+            auto it = pidToUtil.find(pid);
+            proc_info.gpu_usage_percent = it != pidToUtil.end() ? it->second : 0.0f;
 
             result.push_back(std::move(proc_info));
-        }
+        });
     }
 
-    // Get graphics processes
-    std::array<nvmlProcessInfo_t, 128> graphics_processes;
-    unsigned int graphics_count = graphics_processes.size();
-    
-    if (nvmlDeviceGetGraphicsRunningProcesses_ptr(device, &graphics_count, graphics_processes.data()) == NVML_SUCCESS) {
-        debug_print("Found " + std::to_string(graphics_count) + " graphics processes");
-        for (unsigned int p = 0; p < graphics_count; p++) {
-            // Check if process is already in result
-            bool found = false;
-            for (const auto& existing : result) {
-                if (existing.pid == graphics_processes[p].pid) {
-                    found = true;
-                    break;
-                }
-            }
-            
-            if (!found) {
-                GPUProcessInfo proc_info;
-                proc_info.pid = graphics_processes[p].pid;
-                proc_info.process_name = get_process_name(proc_info.pid);
-                proc_info.memory_usage_mb = graphics_processes[p].usedGpuMemory / (1024.0 * 1024.0);
-                
-                // Get GPU utilization from our map
-                proc_info.gpu_usage_percent = pidToUtil.count(proc_info.pid) ? 
-                                            pidToUtil[proc_info.pid] : 0.0f;
-
-                // Debug output
-                debug_print("Process: " + proc_info.process_name + 
-                          " (PID: " + std::to_string(proc_info.pid) + 
-                          ") Memory: " + std::to_string(proc_info.memory_usage_mb) + 
-                          "MB GPU: " + std::to_string(proc_info.gpu_usage_percent) + "%");
-
-                result.push_back(std::move(proc_info));
-            }
-        }
-    }
-    
     return result;
 }
 
 std::vector<GPUProcessInfo> NvidiaGPUDetector::get_all_processes() const {
     std::vector<GPUProcessInfo> result;
-    
-    unsigned int device_count = 0;
-    if (nvmlDeviceGetCount_v2_ptr(&device_count) == NVML_SUCCESS) {
-        for (unsigned int i = 0; i < device_count; i++) {
-            nvmlDevice_t device;
-            if (nvmlDeviceGetHandleByIndex_v2_ptr(i, &device) == NVML_SUCCESS) {
-                auto device_processes = get_process_info_for_device(device);
-                for (auto& proc : device_processes) {
-                    proc.gpu_index = i;
-                }
-                result.insert(result.end(), device_processes.begin(), device_processes.end());
-            }
+
+    std::vector<const DeviceCache*> devices;
+    for (const auto& device : devices_) devices.push_back(&device);
+    warm_up_process_utilization(devices);
+
+    for (const auto& device : devices_) {
+        auto device_processes = get_process_info_for_device(device);
+        for (auto& proc : device_processes) {
+            proc.gpu_index = device.index;
         }
+        result.insert(result.end(), device_processes.begin(), device_processes.end());
     }
-    
+
     return result;
 }
 
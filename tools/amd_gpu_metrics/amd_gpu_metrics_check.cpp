@@ -0,0 +1,138 @@
+// Feeds hand-made gpu_metrics blobs to parse_gpu_metrics and checks the decoded fields.
+//
+// Offsets follow struct gpu_metrics_vX_Y in the kernel's kgd_pp_interface.h. Each blob
+// fills the fields the parser reads with distinct values, so a field read from the
+// wrong layout shows up as a wrong value rather than a plausible one.
+
+#include "amd_gpu_metrics.hpp"
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace hw_monitor;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "PASS " : "FAIL ") << what << "\n";
+    if (!condition) failures++;
+}
+
+template <typename T>
+bool equals(const std::optional<T>& value, T expected) {
+    return value && *value == expected;
+}
+
+/**
+ * Blob with a metrics_table_header, unpopulated fields set to all ones as the firmware does
+ */
+class Blob {
+public:
+    Blob(size_t size, uint8_t format_revision, uint8_t content_revision) : bytes_(size, 0xff) {
+        put<uint16_t>(0, static_cast<uint16_t>(size));
+        bytes_[2] = format_revision;
+        bytes_[3] = content_revision;
+    }
+
+    template <typename T>
+    Blob& put(size_t offset, T value) {
+        std::memcpy(bytes_.data() + offset, &value, sizeof(T));
+        return *this;
+    }
+
+    std::optional<AMDGPUMetrics> parse() const { return parse_gpu_metrics(bytes_.data(), bytes_.size()); }
+
+private:
+    std::vector<uint8_t> bytes_;
+};
+
+} // namespace
+
+int main() {
+    // gpu_metrics_v1_3 (dGPU): units are C, %, W and MHz
+    Blob v1_3(264, 1, 3);
+    v1_3.put<uint16_t>(4, 55).put<uint16_t>(6, 70).put<uint16_t>(8, 62)
+        .put<uint16_t>(16, 87).put<uint16_t>(18, 34).put<uint16_t>(20, 12).put<uint16_t>(22, 180)
+        .put<uint16_t>(54, 2100).put<uint16_t>(56, 1200).put<uint16_t>(58, 1000)
+        .put<uint32_t>(68, 0x4).put<uint16_t>(72, 1500);
+    auto metrics = v1_3.parse();
+    check(metrics && metrics->format_revision == 1 && metrics->content_revision == 3, "v1.3 header");
+    if (metrics) {
+        check(equals(metrics->temperature_celsius, 55.0f) && equals(metrics->hotspot_celsius, 70.0f) &&
+              equals(metrics->memory_temperature_celsius, 62.0f), "v1.3 edge, hotspot and memory temperature");
+        check(equals(metrics->gfx_activity_percent, 87.0f) && equals(metrics->memory_activity_percent, 34.0f) &&
+              equals(metrics->media_activity_percent, 12.0f), "v1.3 gfx, umc and mm activity");
+        check(equals(metrics->socket_power_watts, 180.0f), "v1.3 socket power in W");
+        check(equals(metrics->gfx_clock_mhz, 2100u) && equals(metrics->soc_clock_mhz, 1200u) &&
+              equals(metrics->memory_clock_mhz, 1000u), "v1.3 current clocks");
+        check(equals(metrics->throttle_status, uint64_t{0x4}), "v1.3 throttle status");
+        check(equals(metrics->fan_speed_rpm, 1500u), "v1.3 fan speed");
+    }
+
+    // gpu_metrics_v2_0 (APU): system_clock_counter right after the header, centi-C and mW
+    Blob v2_0(120, 2, 0);
+    v2_0.put<uint64_t>(8, 123456789).put<uint16_t>(16, 4550).put<uint16_t>(18, 4300)
+        .put<uint16_t>(40, 66).put<uint16_t>(42, 9).put<uint16_t>(44, 15000)
+        .put<uint16_t>(80, 1800).put<uint16_t>(82, 900).put<uint16_t>(84, 1600)
+        .put<uint32_t>(112, 0x10);
+    metrics = v2_0.parse();
+    check(metrics && metrics->format_revision == 2 && metrics->content_revision == 0, "v2.0 header");
+    if (metrics) {
+        check(equals(metrics->temperature_celsius, 45.5f), "v2.0 gfx temperature in centi-C");
+        check(equals(metrics->gfx_activity_percent, 66.0f) && equals(metrics->media_activity_percent, 9.0f),
+              "v2.0 gfx and mm activity");
+        check(equals(metrics->socket_power_watts, 15.0f), "v2.0 socket power in mW");
+        check(equals(metrics->gfx_clock_mhz, 1800u) && equals(metrics->soc_clock_mhz, 900u) &&
+              equals(metrics->memory_clock_mhz, 1600u), "v2.0 current clocks");
+        check(equals(metrics->throttle_status, uint64_t{0x10}), "v2.0 throttle status");
+    }
+
+    // gpu_metrics_v2_2 (APU): system_clock_counter moved after the activity fields, and
+    // CPU core temperatures and powers filled in where v2.0 had its fields
+    Blob v2_2(128, 2, 2);
+    for (size_t core = 0; core < 8; core++) {
+        v2_2.put<uint16_t>(8 + 2 * core, 9000);   // temperature_core[]
+        v2_2.put<uint16_t>(48 + 2 * core, 7777);  // average_core_power[]
+        v2_2.put<uint16_t>(88 + 2 * core, 4800);  // current_coreclk[]
+    }
+    v2_2.put<uint16_t>(4, 5125).put<uint16_t>(6, 4900)
+        .put<uint16_t>(28, 42).put<uint16_t>(30, 3).put<uint64_t>(32, 987654321)
+        .put<uint16_t>(40, 22000).put<uint16_t>(42, 11000)
+        .put<uint16_t>(76, 2200).put<uint16_t>(78, 1100).put<uint16_t>(80, 2400)
+        .put<uint32_t>(108, 0x20).put<uint64_t>(120, 0x20);
+    metrics = v2_2.parse();
+    check(metrics && metrics->format_revision == 2 && metrics->content_revision == 2, "v2.2 header");
+    if (metrics) {
+        check(equals(metrics->temperature_celsius, 51.25f), "v2.2 gfx temperature, not a CPU core");
+        check(equals(metrics->gfx_activity_percent, 42.0f) && equals(metrics->media_activity_percent, 3.0f),
+              "v2.2 gfx and mm activity");
+        check(equals(metrics->socket_power_watts, 22.0f), "v2.2 socket power, not a CPU core power");
+        check(equals(metrics->gfx_clock_mhz, 2200u) && equals(metrics->soc_clock_mhz, 1100u) &&
+              equals(metrics->memory_clock_mhz, 2400u), "v2.2 current clocks");
+        check(equals(metrics->throttle_status, uint64_t{0x20}), "v2.2 throttle status");
+    }
+
+    // Unpopulated and truncated fields, unsupported and unknown layouts
+    Blob sparse(264, 1, 3);
+    sparse.put<uint16_t>(4, 40);
+    metrics = sparse.parse();
+    check(metrics && equals(metrics->temperature_celsius, 40.0f) && !metrics->gfx_activity_percent &&
+          !metrics->throttle_status, "all-ones fields reported as missing");
+
+    Blob truncated(20, 2, 2);
+    truncated.put<uint16_t>(4, 3000);
+    metrics = truncated.parse();
+    check(metrics && equals(metrics->temperature_celsius, 30.0f) && !metrics->gfx_activity_percent,
+          "fields past structure_size reported as missing");
+
+    check(!Blob(96, 1, 0).parse(), "v1.0 left to the sysfs fallback");
+    check(!Blob(96, 4, 0).parse(), "unknown format revision rejected");
+    uint8_t header[2] = {4, 0};
+    check(!parse_gpu_metrics(header, sizeof(header)), "truncated header rejected");
+
+    std::cout << (failures == 0 ? "All checks passed\n" : std::to_string(failures) + " checks failed\n");
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,163 @@
+// Runs IntelGPUDetector against the fake sysfs/proc tree in tree/ and checks its output.
+//
+// The tree is copied to a temporary directory first, since the check advances the
+// RC6, energy and fdinfo counters between calls to exercise the rate computations.
+
+#include "intel_gpu_detector.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <cmath>
+#include <cstdlib>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+using namespace hw_monitor;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "PASS " : "FAIL ") << what << "\n";
+    if (!condition) failures++;
+}
+
+bool near(double value, double expected, double tolerance) {
+    return std::fabs(value - expected) <= tolerance;
+}
+
+void write(const fs::path& path, const std::string& content) {
+    std::ofstream(path) << content;
+}
+
+// Replace "key:\t<old>" with "key:\t<value>" in an fdinfo file
+void set_fdinfo(const fs::path& path, const std::string& key, const std::string& value) {
+    std::ifstream in(path);
+    std::string line, content;
+    while (std::getline(in, line)) {
+        if (line.compare(0, key.size() + 1, key + ":") == 0) line = key + ":\t" + value;
+        content += line + "\n";
+    }
+    in.close();
+    write(path, content);
+}
+
+// Busy percentage of an engine, -1 if the engine is not reported
+float engine(const GPUProcessInfo& process, const std::string& name) {
+    auto it = process.engine_usage_percent.find(name);
+    return it != process.engine_usage_percent.end() ? it->second : -1.0f;
+}
+
+const GPUInfo* find_gpu(const std::vector<GPUInfo>& gpus, uint32_t index) {
+    for (const auto& gpu : gpus) {
+        if (gpu.index == index) return &gpu;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+int main() {
+    fs::path root = fs::temp_directory_path() / ("intel_gpu_fixture_" + std::to_string(getpid()));
+    fs::remove_all(root);
+    fs::copy(INTEL_GPU_FIXTURE_TREE, root, fs::copy_options::recursive | fs::copy_options::copy_symlinks);
+
+    fs::path sys = root / "sys";
+    fs::path proc = root / "proc";
+    fs::path i915 = sys / "devices/pci0000:00/0000:00:02.0";
+    fs::path xe = sys / "devices/pci0000:00/0000:03:00.0";
+
+    {
+        IntelGPUDetector detector(sys.string(), proc.string());
+        check(detector.is_available(), "detector finds the fake Intel GPUs");
+
+        // First call takes the 100ms baseline; counters do not move during it
+        auto gpus = detector.get_gpu_info();
+        check(gpus.size() == 2, "i915 and xe cards found, AMD card and connector skipped");
+
+        const GPUInfo* card0 = find_gpu(gpus, 0);
+        const GPUInfo* card1 = find_gpu(gpus, 1);
+        check(card0 && card1, "cards keep their cardN index");
+        if (card0 && card1) {
+            check(card0->pci_bus_id == "0000:00:02.0", "i915 PCI address from the device link");
+            check(card0->graphics_clock_mhz == 1300 && card0->requested_graphics_clock_mhz == 1400,
+                  "i915 gt_act/gt_cur_freq_mhz");
+            check(card0->power_limit_watts == 28.0f, "i915 hwmon power1_max");
+            check(card0->temperature_celsius == 48.0f, "i915 hwmon temp1_input");
+            check(near(card0->energy_joules, 5.0, 1e-9), "i915 hwmon energy1_input");
+            check(near(card0->rc6_residency_percent, 0.0, 0.01), "i915 RC6 idle during baseline");
+            check(near(card0->power_draw_watts, 0.0, 0.01), "i915 no power during baseline");
+            check(card1->graphics_clock_mhz == 900 && card1->requested_graphics_clock_mhz == 2050,
+                  "xe tile0/gt0/freq0 act/cur_freq");
+            check(card1->temperature_celsius == 61.0f, "xe lowest numbered temp*_input");
+            check(card1->energy_joules == -1 && card1->power_limit_watts == -1, "xe without energy or power limit");
+        }
+
+        // 50ms in RC6 and 2J over a ~100ms window: ~50% RC6 and ~20W
+        write(i915 / "drm/card0/power/rc6_residency_ms", "1050\n");
+        write(i915 / "hwmon/hwmon3/energy1_input", "7000000\n");
+        write(xe / "tile0/gt0/gtidle/idle_residency_ms", "100\n");
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        gpus = detector.get_gpu_info();
+        card0 = find_gpu(gpus, 0);
+        card1 = find_gpu(gpus, 1);
+        if (card0 && card1) {
+            check(near(card0->rc6_residency_percent, 45.0, 10.0), "i915 RC6 residency from counter delta");
+            check(near(card0->utilization_percent, 100.0 - card0->rc6_residency_percent, 0.01),
+                  "i915 utilization is time outside RC6");
+            check(near(card0->power_draw_watts, 18.0, 4.0), "i915 power from energy delta");
+            check(near(card1->rc6_residency_percent, 90.0, 10.0), "xe RC6 residency from gtidle");
+        }
+
+        // First call takes the fdinfo baseline
+        auto processes = detector.get_process_info("glxgears");
+        check(processes && processes->size() == 1, "duplicated descriptors count as one client");
+        if (processes && !processes->empty()) {
+            const auto& glxgears = processes->front();
+            check(glxgears.pid == 1000 && glxgears.gpu_index == 0, "glxgears on the i915 card");
+            check(glxgears.memory_usage_mb == 64.0f, "integrated GPU reports system memory");
+        }
+
+        // 50ms of render busy time over a ~100ms window
+        for (const char* fd : {"3", "4"}) {
+            set_fdinfo(proc / "1000/fdinfo" / fd, "drm-engine-render", "51000000 ns");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        processes = detector.get_process_info("glxgears");
+        if (processes && !processes->empty()) {
+            const auto& glxgears = processes->front();
+            check(near(engine(glxgears, "render"), 45.0, 10.0), "render busy from ns delta");
+            check(engine(glxgears, "video") == 0.0f, "idle engine reported as 0");
+            check(glxgears.gpu_usage_percent == engine(glxgears, "render"),
+                  "overall usage is the busiest engine");
+        }
+
+        // Baseline, then one of two vcs instances busy for 100 of 200 cycles: 25%
+        processes = detector.get_process_info(1001u);
+        check(processes && processes->size() == 1, "lookup by PID");
+        set_fdinfo(proc / "1001/fdinfo/5", "drm-cycles-vcs", "200");
+        set_fdinfo(proc / "1001/fdinfo/5", "drm-total-cycles-vcs", "1200");
+        set_fdinfo(proc / "1001/fdinfo/5", "drm-total-cycles-rcs", "1200");
+        processes = detector.get_process_info(1001u);
+        if (processes && !processes->empty()) {
+            const auto& ffmpeg = processes->front();
+            check(ffmpeg.process_name == "ffmpeg" && ffmpeg.gpu_index == 1, "ffmpeg on the xe card");
+            check(ffmpeg.memory_usage_mb == 128.0f, "discrete GPU reports VRAM only");
+            check(near(engine(ffmpeg, "vcs"), 25.0, 0.01), "vcs busy from cycles over capacity");
+            check(engine(ffmpeg, "rcs") == 0.0f, "rcs idle");
+        }
+
+        check(!detector.get_process_info("bash"), "process without DRM clients not reported");
+    }
+
+    {
+        IntelGPUDetector empty((root / "missing").string(), proc.string());
+        check(!empty.is_available(), "missing sysfs tree leaves the detector unavailable");
+    }
+
+    fs::remove_all(root);
+    std::cout << (failures == 0 ? "All checks passed\n" : std::to_string(failures) + " checks failed\n");
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,687 @@
+/**
+ * @brief Mock NVIDIA Management Library
+ *
+ * Builds a stand-in libnvidia-ml.so exporting the NVML entry points used by
+ * NvidiaGPUDetector. Devices, processes, utilization samples and injected error
+ * codes are read from the file named by MOCK_NVML_CONFIG when nvmlInit_v2 is called.
+ * Without a config file a single idle device is exposed.
+ *
+ * Config format (one directive per line, '#' starts a comment):
+ *
+ *   device name="Mock GPU" uuid=GPU-0000 pci_bus_id=00000000:01:00.0 memory_total_mb=16384
+ *          memory_used_mb=1024 temperature=45 utilization=30 memory_utilization=10
+ *          power_w=250 power_limit_w=300 sm_clock=1410 memory_clock=1215 graphics_clock=1410
+ *          pcie_tx_kbps=1000 pcie_rx_kbps=2000 encoder=5 decoder=0 fan=40 pstate=0
+ *          throttle_reasons=0 ecc_corrected=0 ecc_uncorrected=0 idle_gap_every=4 accounting_mode=1
+ *          unsupported=nvmlDeviceGetFanSpeed,nvmlDeviceGetTotalEccErrors
+ *   process device=0 pid=1234 type=compute memory_mb=512 sm=40
+ *   processes device=0 count=500 first_pid=100000 type=graphics memory_mb=64 sm=1
+ *   error function=nvmlDeviceGetProcessUtilization code=3
+ *   event device=0 type=xid data=79 delay_ms=200
+ *   accounting device=0 pid=777 gpu=55 memory=20 max_memory_mb=2048 time_ms=1500 running=0
+ *
+ * nvmlDeviceGetSamples serves a synthetic history of one sample per 1/6 s over the last
+ * 10 s, built from the device values; with idle_gap_every=N every Nth GPU utilization
+ * sample is 0.
+ *
+ * Events fire once, delay_ms after an event set registers their device; type is one of
+ * xid, dbe (double-bit ECC), sbe (single-bit ECC), pstate or clock.
+ *
+ * mockNvmlGetCallCount(name) reports how often an entry point was called, for
+ * checking that callers avoid redundant queries.
+ */
+
+#include "nvidia_gpu_detector.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct MockProcess {
+    unsigned int pid = 0;
+    bool graphics = false;
+    unsigned long long memory_bytes = 0;
+    unsigned int sm_util = 0;
+};
+
+} // namespace
+
+/// Device handles handed out by the mock point at these
+struct nvmlDevice_st {
+    std::string name = "Mock GPU";
+    std::string uuid;
+    std::string pci_bus_id;
+    unsigned long long memory_total = 16ull << 30;
+    unsigned long long memory_used = 0;
+    unsigned int temperature = 40;
+    unsigned int utilization = 0;
+    unsigned int memory_utilization = 0;
+    unsigned int power_mw = 75000;
+    unsigned int power_limit_mw = 300000;
+    unsigned int sm_clock = 1410;
+    unsigned int memory_clock = 1215;
+    unsigned int graphics_clock = 1410;
+    unsigned int pcie_tx_kbps = 1000;
+    unsigned int pcie_rx_kbps = 2000;
+    unsigned int encoder = 0;
+    unsigned int decoder = 0;
+    unsigned int fan = 30;
+    unsigned int pstate = 0;
+    unsigned long long throttle_reasons = 0;
+    unsigned long long ecc_corrected = 0;
+    unsigned long long ecc_uncorrected = 0;
+    unsigned long long idle_gap_every = 0;
+    bool accounting_mode = false;
+    std::vector<std::pair<unsigned int, nvmlAccountingStats_t>> accounting;
+    std::set<std::string> unsupported;          ///< Entry points answering NVML_ERROR_NOT_SUPPORTED
+    std::vector<MockProcess> processes;
+};
+
+namespace {
+
+struct MockEvent {
+    size_t device = 0;
+    unsigned long long type = 0;
+    unsigned long long data = 0;
+    unsigned long long delay_ms = 0;
+};
+
+struct MockState {
+    std::mutex mutex;
+    std::vector<nvmlDevice_st> devices;
+    std::vector<MockEvent> events;
+    std::map<std::string, nvmlReturn_t> errors;
+    std::map<std::string, unsigned long long> calls;
+    bool initialized = false;
+};
+
+MockState& state() {
+    static MockState instance;
+    return instance;
+}
+
+/**
+ * Split a config line into key=value pairs; values may be double-quoted
+ */
+std::map<std::string, std::string> parse_fields(std::istringstream& iss) {
+    std::map<std::string, std::string> fields;
+    std::string token;
+    while (iss >> token) {
+        size_t eq = token.find('=');
+        if (eq == std::string::npos) continue;
+
+        std::string key = token.substr(0, eq);
+        std::string value = token.substr(eq + 1);
+        if (!value.empty() && value.front() == '"') {
+            value.erase(0, 1);
+            while (value.empty() || value.back() != '"') {
+                std::string rest;
+                if (!(iss >> rest)) break;
+                value += " " + rest;
+            }
+            if (!value.empty() && value.back() == '"') value.pop_back();
+        }
+        fields[key] = value;
+    }
+    return fields;
+}
+
+unsigned long long field_number(const std::map<std::string, std::string>& fields,
+                                const std::string& key, unsigned long long fallback) {
+    auto it = fields.find(key);
+    return it != fields.end() ? std::strtoull(it->second.c_str(), nullptr, 10) : fallback;
+}
+
+std::string field_string(const std::map<std::string, std::string>& fields,
+                         const std::string& key, const std::string& fallback) {
+    auto it = fields.find(key);
+    return it != fields.end() ? it->second : fallback;
+}
+
+void load_config(MockState& s) {
+    s.devices.clear();
+    s.errors.clear();
+    s.events.clear();
+
+    const char* path = std::getenv("MOCK_NVML_CONFIG");
+    std::ifstream config(path ? path : "");
+    std::string line;
+    while (config && std::getline(config, line)) {
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+
+        std::istringstream iss(line);
+        std::string directive;
+        if (!(iss >> directive)) continue;
+        auto fields = parse_fields(iss);
+
+        if (directive == "device") {
+            nvmlDevice_st device;
+            size_t index = s.devices.size();
+            device.name = field_string(fields, "name", device.name);
+            char default_uuid[NVML_DEVICE_UUID_V2_BUFFER_SIZE];
+            char default_bus_id[NVML_DEVICE_PCI_BUS_ID_BUFFER_SIZE];
+            std::snprintf(default_uuid, sizeof(default_uuid), "GPU-00000000-0000-0000-0000-%012zx", index);
+            std::snprintf(default_bus_id, sizeof(default_bus_id), "00000000:%02zX:00.0", index + 1);
+            device.uuid = field_string(fields, "uuid", default_uuid);
+            device.pci_bus_id = field_string(fields, "pci_bus_id", default_bus_id);
+            device.memory_total = field_number(fields, "memory_total_mb", 16384) << 20;
+            device.memory_used = field_number(fields, "memory_used_mb", 0) << 20;
+            device.temperature = field_number(fields, "temperature", device.temperature);
+            device.utilization = field_number(fields, "utilization", device.utilization);
+            device.memory_utilization = field_number(fields, "memory_utilization", device.memory_utilization);
+            device.power_mw = field_number(fields, "power_w", device.power_mw / 1000) * 1000;
+            device.power_limit_mw = field_number(fields, "power_limit_w", device.power_limit_mw / 1000) * 1000;
+            device.sm_clock = field_number(fields, "sm_clock", device.sm_clock);
+            device.memory_clock = field_number(fields, "memory_clock", device.memory_clock);
+            device.graphics_clock = field_number(fields, "graphics_clock", device.graphics_clock);
+            device.pcie_tx_kbps = field_number(fields, "pcie_tx_kbps", device.pcie_tx_kbps);
+            device.pcie_rx_kbps = field_number(fields, "pcie_rx_kbps", device.pcie_rx_kbps);
+            device.encoder = field_number(fields, "encoder", device.encoder);
+            device.decoder = field_number(fields, "decoder", device.decoder);
+            device.fan = field_number(fields, "fan", device.fan);
+            device.pstate = field_number(fields, "pstate", device.pstate);
+            device.throttle_reasons = field_number(fields, "throttle_reasons", device.throttle_reasons);
+            device.ecc_corrected = field_number(fields, "ecc_corrected", device.ecc_corrected);
+            device.ecc_uncorrected = field_number(fields, "ecc_uncorrected", device.ecc_uncorrected);
+            device.idle_gap_every = field_number(fields, "idle_gap_every", device.idle_gap_every);
+            device.accounting_mode = field_number(fields, "accounting_mode", 0) != 0;
+
+            std::istringstream unsupported(field_string(fields, "unsupported", ""));
+            std::string function;
+            while (std::getline(unsupported, function, ',')) {
+                if (!function.empty()) device.unsupported.insert(function);
+            }
+            s.devices.push_back(std::move(device));
+        } else if (directive == "process" || directive == "processes") {
+            size_t index = field_number(fields, "device", s.devices.empty() ? 0 : s.devices.size() - 1);
+            if (index >= s.devices.size()) continue;
+
+            MockProcess process;
+            process.graphics = field_string(fields, "type", "compute") == "graphics";
+            process.memory_bytes = field_number(fields, "memory_mb", 0) << 20;
+            process.sm_util = field_number(fields, "sm", 0);
+
+            unsigned long long first_pid = field_number(fields, directive == "process" ? "pid" : "first_pid", 1);
+            unsigned long long count = directive == "process" ? 1 : field_number(fields, "count", 1);
+            for (unsigned long long i = 0; i < count; i++) {
+                process.pid = static_cast<unsigned int>(first_pid + i);
+                s.devices[index].processes.push_back(process);
+            }
+        } else if (directive == "event") {
+            static const std::map<std::string, unsigned long long> event_types = {
+                {"xid", nvmlEventTypeXidCriticalError},
+                {"dbe", nvmlEventTypeDoubleBitEccError},
+                {"sbe", nvmlEventTypeSingleBitEccError},
+                {"pstate", nvmlEventTypePState},
+                {"clock", nvmlEventTypeClock}
+            };
+            auto type = event_types.find(field_string(fields, "type", "xid"));
+            if (type == event_types.end()) continue;
+
+            MockEvent event;
+            event.device = field_number(fields, "device", 0);
+            event.type = type->second;
+            event.data = field_number(fields, "data", 0);
+            event.delay_ms = field_number(fields, "delay_ms", 0);
+            s.events.push_back(event);
+        } else if (directive == "accounting") {
+            size_t index = field_number(fields, "device", s.devices.empty() ? 0 : s.devices.size() - 1);
+            if (index >= s.devices.size()) continue;
+
+            nvmlAccountingStats_t stats{};
+            stats.gpuUtilization = field_number(fields, "gpu", 0);
+            stats.memoryUtilization = field_number(fields, "memory", 0);
+            stats.maxMemoryUsage = field_number(fields, "max_memory_mb", 0) << 20;
+            stats.time = field_number(fields, "time_ms", 0);
+            stats.startTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count() - stats.time * 1000;
+            stats.isRunning = field_number(fields, "running", 0) != 0;
+            s.devices[index].accounting.emplace_back(field_number(fields, "pid", 1), stats);
+        } else if (directive == "error") {
+            s.errors[field_string(fields, "function", "")] =
+                static_cast<nvmlReturn_t>(field_number(fields, "code", NVML_ERROR_UNKNOWN));
+        }
+    }
+
+    if (s.devices.empty()) {
+        nvmlDevice_st device;
+        device.uuid = "GPU-00000000-0000-0000-0000-000000000000";
+        device.pci_bus_id = "00000000:01:00.0";
+        s.devices.push_back(std::move(device));
+    }
+}
+
+/**
+ * Common prologue: injected error for this entry point, initialization and handle checks
+ */
+nvmlReturn_t check_call(MockState& s, const char* function, nvmlDevice_t device = nullptr, bool needs_device = false) {
+    s.calls[function]++;
+    auto it = s.errors.find(function);
+    if (it != s.errors.end()) return it->second;
+    if (!s.initialized) return NVML_ERROR_UNINITIALIZED;
+    if (needs_device && device == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    if (device && device->unsupported.count(function)) return NVML_ERROR_NOT_SUPPORTED;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t copy_string(const std::string& value, char* buffer, unsigned int length) {
+    if (buffer == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    if (value.size() + 1 > length) return NVML_ERROR_INSUFFICIENT_SIZE;
+    std::memcpy(buffer, value.c_str(), value.size() + 1);
+    return NVML_SUCCESS;
+}
+
+/**
+ * Fill a running-process list following the NVML count protocol
+ */
+template<typename Info>
+nvmlReturn_t list_processes(nvmlDevice_t device, bool graphics, unsigned int* count, Info* infos) {
+    if (count == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+
+    std::vector<const MockProcess*> matching;
+    for (const auto& process : device->processes) {
+        if (process.graphics == graphics) matching.push_back(&process);
+    }
+
+    unsigned int capacity = *count;
+    *count = static_cast<unsigned int>(matching.size());
+    if (matching.empty()) return NVML_SUCCESS;
+    if (infos == nullptr || capacity < matching.size()) return NVML_ERROR_INSUFFICIENT_SIZE;
+
+    for (size_t i = 0; i < matching.size(); i++) {
+        Info info{};
+        info.pid = matching[i]->pid;
+        info.usedGpuMemory = matching[i]->memory_bytes;
+        infos[i] = info;
+    }
+    return NVML_SUCCESS;
+}
+
+} // namespace
+
+/// Event sets track which devices registered when, and which events were delivered
+struct nvmlEventSet_st {
+    std::map<size_t, std::pair<unsigned long long, std::chrono::steady_clock::time_point>> registrations;
+    std::set<size_t> delivered;
+};
+
+#define MOCK_PROLOGUE(...)                                              \
+    auto& s = state();                                                  \
+    std::lock_guard<std::mutex> lock(s.mutex);                          \
+    if (nvmlReturn_t ret = check_call(s, __func__, ##__VA_ARGS__); ret != NVML_SUCCESS) return ret
+
+extern "C" {
+
+nvmlReturn_t nvmlInit_v2() {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    load_config(s);
+    auto it = s.errors.find(__func__);
+    if (it != s.errors.end()) return it->second;
+    s.initialized = true;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlShutdown() {
+    MOCK_PROLOGUE();
+    s.initialized = false;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetCount_v2(unsigned int* count) {
+    MOCK_PROLOGUE();
+    if (count == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *count = static_cast<unsigned int>(s.devices.size());
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetHandleByIndex_v2(unsigned int index, nvmlDevice_t* device) {
+    MOCK_PROLOGUE();
+    if (device == nullptr || index >= s.devices.size()) return NVML_ERROR_INVALID_ARGUMENT;
+    *device = &s.devices[index];
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetName(nvmlDevice_t device, char* name, unsigned int length) {
+    MOCK_PROLOGUE(device, true);
+    return copy_string(device->name, name, length);
+}
+
+nvmlReturn_t nvmlDeviceGetUUID(nvmlDevice_t device, char* uuid, unsigned int length) {
+    MOCK_PROLOGUE(device, true);
+    return copy_string(device->uuid, uuid, length);
+}
+
+nvmlReturn_t nvmlDeviceGetPciInfo_v3(nvmlDevice_t device, nvmlPciInfo_t* pci) {
+    MOCK_PROLOGUE(device, true);
+    if (pci == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *pci = nvmlPciInfo_t{};
+    std::strncpy(pci->busId, device->pci_bus_id.c_str(), sizeof(pci->busId) - 1);
+    std::strncpy(pci->busIdLegacy, device->pci_bus_id.c_str(), sizeof(pci->busIdLegacy) - 1);
+    pci->pciDeviceId = 0x000010de;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetMemoryInfo(nvmlDevice_t device, nvmlMemory_t* memory) {
+    MOCK_PROLOGUE(device, true);
+    if (memory == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    memory->total = device->memory_total;
+    memory->used = device->memory_used;
+    memory->free = device->memory_total - device->memory_used;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetTemperature(nvmlDevice_t device, nvmlTemperatureSensors_t, unsigned int* temperature) {
+    MOCK_PROLOGUE(device, true);
+    if (temperature == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *temperature = device->temperature;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetUtilizationRates(nvmlDevice_t device, nvmlUtilization_t* utilization) {
+    MOCK_PROLOGUE(device, true);
+    if (utilization == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    utilization->gpu = device->utilization;
+    utilization->memory = device->memory_utilization;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetComputeRunningProcesses_v3(nvmlDevice_t device, unsigned int* count, nvmlProcessInfo_t* infos) {
+    MOCK_PROLOGUE(device, true);
+    return list_processes(device, false, count, infos);
+}
+
+nvmlReturn_t nvmlDeviceGetGraphicsRunningProcesses_v3(nvmlDevice_t device, unsigned int* count, nvmlProcessInfo_t* infos) {
+    MOCK_PROLOGUE(device, true);
+    return list_processes(device, true, count, infos);
+}
+
+nvmlReturn_t nvmlDeviceGetComputeRunningProcesses_v2(nvmlDevice_t device, unsigned int* count, nvmlProcessInfo_t* infos) {
+    MOCK_PROLOGUE(device, true);
+    return list_processes(device, false, count, infos);
+}
+
+nvmlReturn_t nvmlDeviceGetGraphicsRunningProcesses_v2(nvmlDevice_t device, unsigned int* count, nvmlProcessInfo_t* infos) {
+    MOCK_PROLOGUE(device, true);
+    return list_processes(device, true, count, infos);
+}
+
+nvmlReturn_t nvmlDeviceGetComputeRunningProcesses(nvmlDevice_t device, unsigned int* count, nvmlProcessInfo_v1_t* infos) {
+    MOCK_PROLOGUE(device, true);
+    return list_processes(device, false, count, infos);
+}
+
+nvmlReturn_t nvmlDeviceGetGraphicsRunningProcesses(nvmlDevice_t device, unsigned int* count, nvmlProcessInfo_v1_t* infos) {
+    MOCK_PROLOGUE(device, true);
+    return list_processes(device, true, count, infos);
+}
+
+nvmlReturn_t nvmlDeviceGetProcessUtilization(nvmlDevice_t device, nvmlProcessUtilizationSample_t* utilization,
+                                             unsigned int* processSamplesCount, unsigned long long lastSeenTimeStamp) {
+    MOCK_PROLOGUE(device, true);
+    if (processSamplesCount == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+
+    // Every process has exactly one sample, stamped with the current time
+    unsigned long long now = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    if (now <= lastSeenTimeStamp || device->processes.empty()) {
+        *processSamplesCount = 0;
+        return NVML_ERROR_NOT_FOUND;
+    }
+
+    unsigned int capacity = *processSamplesCount;
+    *processSamplesCount = static_cast<unsigned int>(device->processes.size());
+    if (utilization == nullptr || capacity < device->processes.size()) return NVML_ERROR_INSUFFICIENT_SIZE;
+
+    for (size_t i = 0; i < device->processes.size(); i++) {
+        utilization[i] = nvmlProcessUtilizationSample_t{};
+        utilization[i].pid = device->processes[i].pid;
+        utilization[i].timeStamp = now;
+        utilization[i].smUtil = device->processes[i].sm_util;
+    }
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetPowerUsage(nvmlDevice_t device, unsigned int* power) {
+    MOCK_PROLOGUE(device, true);
+    if (power == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *power = device->power_mw;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetEnforcedPowerLimit(nvmlDevice_t device, unsigned int* limit) {
+    MOCK_PROLOGUE(device, true);
+    if (limit == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *limit = device->power_limit_mw;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetClockInfo(nvmlDevice_t device, nvmlClockType_t type, unsigned int* clock) {
+    MOCK_PROLOGUE(device, true);
+    if (clock == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    switch (type) {
+        case NVML_CLOCK_GRAPHICS: *clock = device->graphics_clock; return NVML_SUCCESS;
+        case NVML_CLOCK_SM: *clock = device->sm_clock; return NVML_SUCCESS;
+        case NVML_CLOCK_MEM: *clock = device->memory_clock; return NVML_SUCCESS;
+        default: return NVML_ERROR_NOT_SUPPORTED;
+    }
+}
+
+nvmlReturn_t nvmlDeviceGetPcieThroughput(nvmlDevice_t device, nvmlPcieUtilCounter_t counter, unsigned int* value) {
+    MOCK_PROLOGUE(device, true);
+    if (value == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *value = counter == NVML_PCIE_UTIL_TX_BYTES ? device->pcie_tx_kbps : device->pcie_rx_kbps;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetEncoderUtilization(nvmlDevice_t device, unsigned int* utilization, unsigned int* samplingPeriodUs) {
+    MOCK_PROLOGUE(device, true);
+    if (utilization == nullptr || samplingPeriodUs == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *utilization = device->encoder;
+    *samplingPeriodUs = 167000;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetDecoderUtilization(nvmlDevice_t device, unsigned int* utilization, unsigned int* samplingPeriodUs) {
+    MOCK_PROLOGUE(device, true);
+    if (utilization == nullptr || samplingPeriodUs == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *utilization = device->decoder;
+    *samplingPeriodUs = 167000;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetFanSpeed(nvmlDevice_t device, unsigned int* speed) {
+    MOCK_PROLOGUE(device, true);
+    if (speed == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *speed = device->fan;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetPerformanceState(nvmlDevice_t device, nvmlPstates_t* pstate) {
+    MOCK_PROLOGUE(device, true);
+    if (pstate == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *pstate = static_cast<nvmlPstates_t>(device->pstate);
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetCurrentClocksThrottleReasons(nvmlDevice_t device, unsigned long long* reasons) {
+    MOCK_PROLOGUE(device, true);
+    if (reasons == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *reasons = device->throttle_reasons;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetTotalEccErrors(nvmlDevice_t device, nvmlMemoryErrorType_t type, nvmlEccCounterType_t,
+                                         unsigned long long* count) {
+    MOCK_PROLOGUE(device, true);
+    if (count == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *count = type == NVML_MEMORY_ERROR_TYPE_CORRECTED ? device->ecc_corrected : device->ecc_uncorrected;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetSamples(nvmlDevice_t device, nvmlSamplingType_t type, unsigned long long lastSeenTimeStamp,
+                                  nvmlValueType_t* sampleValType, unsigned int* sampleCount, nvmlSample_t* samples) {
+    MOCK_PROLOGUE(device, true);
+    if (sampleValType == nullptr || sampleCount == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+
+    const unsigned long long period_us = 1000000 / 6;
+    const unsigned long long history = 60;
+    unsigned long long now = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    unsigned long long last = now / period_us;
+    unsigned long long first = std::max(last - history + 1, lastSeenTimeStamp / period_us + 1);
+    if (first > last) {
+        *sampleCount = 0;
+        return NVML_ERROR_NOT_FOUND;
+    }
+
+    unsigned int needed = static_cast<unsigned int>(last - first + 1);
+    *sampleValType = NVML_VALUE_TYPE_UNSIGNED_INT;
+    if (samples == nullptr) {
+        *sampleCount = needed;
+        return NVML_SUCCESS;
+    }
+    if (*sampleCount < needed) {
+        *sampleCount = needed;
+        return NVML_ERROR_INSUFFICIENT_SIZE;
+    }
+
+    for (unsigned long long k = first; k <= last; k++) {
+        unsigned int value = 0;
+        switch (type) {
+            case NVML_TOTAL_POWER_SAMPLES: value = device->power_mw; break;
+            case NVML_GPU_UTILIZATION_SAMPLES:
+                value = device->idle_gap_every && k % device->idle_gap_every == 0 ? 0 : device->utilization;
+                break;
+            case NVML_MEMORY_UTILIZATION_SAMPLES: value = device->memory_utilization; break;
+            case NVML_ENC_UTILIZATION_SAMPLES: value = device->encoder; break;
+            case NVML_DEC_UTILIZATION_SAMPLES: value = device->decoder; break;
+            case NVML_PROCESSOR_CLK_SAMPLES: value = device->sm_clock; break;
+            case NVML_MEMORY_CLK_SAMPLES: value = device->memory_clock; break;
+            default: return NVML_ERROR_NOT_SUPPORTED;
+        }
+        nvmlSample_t& sample = samples[k - first];
+        sample.timeStamp = k * period_us;
+        sample.sampleValue.uiVal = value;
+    }
+    *sampleCount = needed;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetAccountingMode(nvmlDevice_t device, nvmlEnableState_t* mode) {
+    MOCK_PROLOGUE(device, true);
+    if (mode == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *mode = device->accounting_mode ? NVML_FEATURE_ENABLED : NVML_FEATURE_DISABLED;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetAccountingPids(nvmlDevice_t device, unsigned int* count, unsigned int* pids) {
+    MOCK_PROLOGUE(device, true);
+    if (count == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    if (!device->accounting_mode) return NVML_ERROR_NOT_SUPPORTED;
+
+    unsigned int capacity = *count;
+    *count = static_cast<unsigned int>(device->accounting.size());
+    if (pids == nullptr || capacity < device->accounting.size()) {
+        return device->accounting.empty() ? NVML_SUCCESS : NVML_ERROR_INSUFFICIENT_SIZE;
+    }
+    for (size_t i = 0; i < device->accounting.size(); i++) {
+        pids[i] = device->accounting[i].first;
+    }
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetAccountingStats(nvmlDevice_t device, unsigned int pid, nvmlAccountingStats_t* stats) {
+    MOCK_PROLOGUE(device, true);
+    if (stats == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    if (!device->accounting_mode) return NVML_ERROR_NOT_SUPPORTED;
+    for (const auto& [accounted_pid, accounted] : device->accounting) {
+        if (accounted_pid == pid) {
+            *stats = accounted;
+            return NVML_SUCCESS;
+        }
+    }
+    return NVML_ERROR_NOT_FOUND;
+}
+
+nvmlReturn_t nvmlEventSetCreate(nvmlEventSet_t* set) {
+    MOCK_PROLOGUE();
+    if (set == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *set = new nvmlEventSet_st();
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlEventSetFree(nvmlEventSet_t set) {
+    MOCK_PROLOGUE();
+    delete set;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetSupportedEventTypes(nvmlDevice_t device, unsigned long long* eventTypes) {
+    MOCK_PROLOGUE(device, true);
+    if (eventTypes == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    *eventTypes = nvmlEventTypeSingleBitEccError | nvmlEventTypeDoubleBitEccError | nvmlEventTypePState |
+                  nvmlEventTypeXidCriticalError | nvmlEventTypeClock;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceRegisterEvents(nvmlDevice_t device, unsigned long long eventTypes, nvmlEventSet_t set) {
+    MOCK_PROLOGUE(device, true);
+    if (set == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+    size_t index = static_cast<size_t>(device - s.devices.data());
+    set->registrations[index] = {eventTypes, std::chrono::steady_clock::now()};
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlEventSetWait_v2(nvmlEventSet_t set, nvmlEventData_t* data, unsigned int timeoutms) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutms);
+    while (true) {
+        {
+            MOCK_PROLOGUE();
+            if (set == nullptr || data == nullptr) return NVML_ERROR_INVALID_ARGUMENT;
+
+            auto now = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < s.events.size(); i++) {
+                const auto& event = s.events[i];
+                auto registration = set->registrations.find(event.device);
+                if (registration == set->registrations.end() || event.device >= s.devices.size()) continue;
+                if (!(registration->second.first & event.type) || set->delivered.count(i)) continue;
+                if (now < registration->second.second + std::chrono::milliseconds(event.delay_ms)) continue;
+
+                set->delivered.insert(i);
+                *data = nvmlEventData_t{};
+                data->device = &s.devices[event.device];
+                data->eventType = event.type;
+                data->eventData = event.data;
+                return NVML_SUCCESS;
+            }
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline) return NVML_ERROR_TIMEOUT;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+/**
+ * Not part of NVML: number of calls made to an entry point since the library was loaded
+ */
+unsigned long long mockNvmlGetCallCount(const char* function) {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.calls.find(function ? function : "");
+    return it != s.calls.end() ? it->second : 0;
+}
+
+} // extern "C"
@@ -0,0 +1,137 @@
+// Runs NvidiaGPUDetector against the mock NVML configured with example.conf and checks its output.
+//
+// ctest sets HW_MONITOR_NVML_LIBRARY and MOCK_NVML_CONFIG. The mock's own call counters,
+// read through mockNvmlGetCallCount, verify that handles and static attributes are
+// resolved once and that unsupported queries and the process buffer are not retried.
+// The event lines of example.conf drive the event listener.
+
+#include "nvidia_gpu_detector.hpp"
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <vector>
+#include <dlfcn.h>
+
+using namespace hw_monitor;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "PASS " : "FAIL ") << what << "\n";
+    if (!condition) failures++;
+}
+
+const GPUInfo* find_gpu(const std::vector<GPUInfo>& gpus, uint32_t index) {
+    for (const auto& gpu : gpus) {
+        if (gpu.index == index) return &gpu;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+int main() {
+    const char* library = std::getenv("HW_MONITOR_NVML_LIBRARY");
+    if (!library || !std::getenv("MOCK_NVML_CONFIG")) {
+        std::cerr << "HW_MONITOR_NVML_LIBRARY and MOCK_NVML_CONFIG must be set\n";
+        return EXIT_FAILURE;
+    }
+
+    // Same library the detector loads, so the counters are the ones it increments
+    void* mock = dlopen(library, RTLD_LAZY);
+    auto call_count = mock ? reinterpret_cast<unsigned long long (*)(const char*)>(dlsym(mock, "mockNvmlGetCallCount"))
+                           : nullptr;
+    if (!call_count) {
+        std::cerr << "Cannot load mockNvmlGetCallCount from " << library << "\n";
+        return EXIT_FAILURE;
+    }
+
+    {
+        NvidiaGPUDetector detector;
+        check(detector.is_available(), "detector initializes against the mock");
+
+        auto gpus = detector.get_gpu_info();
+        check(gpus.size() == 2, "both configured devices found");
+        const GPUInfo* a100 = find_gpu(gpus, 0);
+        const GPUInfo* l4 = find_gpu(gpus, 1);
+        check(a100 && l4, "devices keep their NVML index");
+        if (a100 && l4) {
+            check(a100->name == "Mock A100" && a100->uuid == "GPU-11111111-2222-3333-4444-555555555555" &&
+                  a100->pci_bus_id == "00000000:3B:00.0", "A100 name, UUID and PCI bus ID");
+            check(a100->total_memory_mb == 40960.0f && a100->used_memory_mb == 12288.0f, "A100 memory");
+            check(a100->temperature_celsius == 61.0f && a100->utilization_percent == 87.0f,
+                  "A100 temperature and utilization");
+            check(a100->power_draw_watts == 310.0f && a100->power_limit_watts == 400.0f, "A100 power");
+            check(a100->sm_clock_mhz == 1410 && a100->memory_clock_mhz == 1215, "A100 clocks");
+            check(a100->pcie_tx_kbps == 52000 && a100->pcie_rx_kbps == 180000, "A100 PCIe throughput");
+            check(a100->throttle_reasons == 4 && a100->ecc_corrected_errors == 3, "A100 throttle reasons and ECC");
+            check(a100->processes.size() == 3, "A100 compute and graphics processes");
+            check(l4->encoder_utilization_percent == 35.0f && l4->decoder_utilization_percent == 60.0f &&
+                  l4->performance_state == 2, "L4 encoder, decoder and P-state");
+            check(l4->fan_speed_percent == -1 && l4->ecc_corrected_errors == -1, "L4 unsupported queries left unset");
+            check(l4->processes.size() == 400, "L4 reports all 400 processes through the growing buffer");
+        }
+
+        // Static attributes and handles are resolved once, at construction
+        unsigned long long compute_queries = call_count("nvmlDeviceGetComputeRunningProcesses_v3");
+        unsigned long long fan_queries = call_count("nvmlDeviceGetFanSpeed");
+        detector.get_gpu_info();
+        detector.get_gpu_info();
+        for (const char* function : {"nvmlDeviceGetHandleByIndex_v2", "nvmlDeviceGetName", "nvmlDeviceGetUUID",
+                                     "nvmlDeviceGetPciInfo_v3"}) {
+            check(call_count(function) == 2, std::string(function) + " called once per device");
+        }
+        check(call_count("nvmlDeviceGetComputeRunningProcesses_v3") - compute_queries == 4,
+              "grown process buffer reused: one compute query per device and poll");
+        check(call_count("nvmlDeviceGetFanSpeed") - fan_queries == 2,
+              "fan speed not queried again on the device that does not support it");
+
+        auto processes = detector.get_process_info(4242u);
+        check(processes && processes->size() == 1, "lookup by PID");
+        if (processes && !processes->empty()) {
+            const auto& process = processes->front();
+            check(process.gpu_index == 0 && process.memory_usage_mb == 8192.0f, "PID 4242 memory on GPU 0");
+            check(process.gpu_usage_percent == 70.0f, "PID 4242 SM utilization from samples");
+        }
+        processes = detector.get_process_info(200399u);
+        check(processes && processes->size() == 1 && processes->front().gpu_index == 1 &&
+              processes->front().memory_usage_mb == 48.0f, "last of the 400 L4 processes found by PID");
+        check(!detector.get_process_info("no-such-process-name"), "unknown process name not reported");
+
+        // example.conf raises a P-state change on GPU 0 after 100ms and XID 79 on GPU 1 after 300ms
+        std::mutex events_mutex;
+        std::condition_variable events_cv;
+        std::vector<GPUEvent> events;
+        bool started = detector.start_event_listener([&](const GPUEvent& event) {
+            std::lock_guard<std::mutex> lock(events_mutex);
+            events.push_back(event);
+            events_cv.notify_all();
+        });
+        check(started, "event listener starts");
+        {
+            std::unique_lock<std::mutex> lock(events_mutex);
+            events_cv.wait_for(lock, std::chrono::seconds(2), [&] { return events.size() >= 2; });
+            check(events.size() == 2, "both configured events delivered");
+            if (events.size() == 2) {
+                check(events[0].type == GPUEventType::PerformanceStateChange && events[0].gpu_index == 0,
+                      "P-state change on GPU 0");
+                check(events[1].type == GPUEventType::XidCriticalError && events[1].gpu_index == 1 &&
+                      events[1].data == 79, "XID 79 on GPU 1");
+            }
+        }
+
+        // The listener waits at most 200ms per call; allow for scheduling delays on top
+        auto stop_start = std::chrono::steady_clock::now();
+        detector.stop_event_listener();
+        auto stop_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - stop_start).count();
+        check(stop_ms <= 300, "stop_event_listener joins within the wait bound (" + std::to_string(stop_ms) + "ms)");
+    }
+
+    dlclose(mock);
+    std::cout << (failures == 0 ? "All checks passed\n" : std::to_string(failures) + " checks failed\n");
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}